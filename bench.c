@@ -0,0 +1,580 @@
+/*
+ *  Project: Doubly Linked List C-API, benchmark program
+ *  File:   bench.c
+ *  Author: Chris Aslanoglou
+ *  Github: https://github.com/chris-asl/doubly-linked-list-API
+ *
+ *  Times the core operations of the API on lists of datatype_int elements of
+ *  growing sizes, and reports for every scenario and size the time and the
+ *  allocations per operation along with the peak RSS, as JSON (stdout).
+ *  Every run happens in a child process of its own, so that runs do not share
+ *  their heap or their peak RSS, and keys come from a fixed seed, so that
+ *  runs are reproducible. Allocations are counted by wrapping malloc, calloc
+ *  and realloc at link time (see the Makefile)
+ *
+ *  Usage: bench [-k plain|pooled|inline|unrolled] [-f] [-i] [-m max_size]
+ *               [-t nthreads] [scenario ...]
+ *  Sizes go from 1000 up to max_size (default 1000000) by factors of 10,
+ *  -f enables the finger of the lists (see dll_fingerEnable) and -i their
+ *  skip index (see dll_indexEnable), while -t sets the threads of the
+ *  parallel scenarios (default 4). Cutting the list into runs for the threads
+ *  takes a pass over the list, or O(log n) per run with -i, so comparing
+ *  reduce under -t 1 (no cut at all), -t n and -t n -i shows its cost.
+ *  Unrolled lists (see dll_init_unrolled) skip the scenarios of the bulk
+ *  operations they do not support (reduce and load), and take neither -f
+ *  nor -i
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "doubly_linked_list_adt.h"
+#include "datatype_int.h"
+
+// Keyed scenarios cost O(size) per operation, so they only run as many
+// operations as it takes to visit about this many nodes (at most 1000)
+#define KEYED_VISITS 100000000L
+#define KEYED_OPS 1000L
+#define SEED 42
+
+// Allocation counting, through -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+unsigned long allocations = 0;
+
+void* __real_malloc(size_t);
+void* __real_calloc(size_t, size_t);
+void* __real_realloc(void*, size_t);
+
+void* __wrap_malloc(size_t size)
+{
+    allocations++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+// List kind under test
+enum kind { PLAIN, POOLED, INLINE, UNROLLED };
+const char* kind_names[] = { "plain", "pooled", "inline", "unrolled" };
+int use_finger = 0, use_index = 0, nthreads = 4;
+
+struct result
+{
+    long ops;
+    double ns;
+    unsigned long allocs;
+};
+
+struct timespec start_time;
+unsigned long start_allocations;
+
+void start(void)
+{
+    start_allocations = allocations;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+}
+
+void stop(struct result* r, long ops)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    r->allocs = allocations - start_allocations;
+    r->ns = (end.tv_sec - start_time.tv_sec) * 1e9 +
+            (end.tv_nsec - start_time.tv_nsec);
+    r->ops = ops;
+}
+
+list_t new_list(enum kind kind)
+{
+    list_t list = NULL;
+    int retval;
+    if (kind == POOLED)
+        retval = dll_init_pooled(&list, 0);
+    else if (kind == INLINE)
+        retval = dll_init_inline(&list, sizeof(struct Datatype_int));
+    else if (kind == UNROLLED)
+        retval = dll_init_unrolled(&list, 0);
+    else
+        retval = dll_init(&list);
+    if (retval == -1 || (use_finger && dll_fingerEnable(list) == -1) ||
+            (use_index && dll_indexEnable(list) == -1))
+        exit(EXIT_FAILURE);
+    return list;
+}
+
+// Fills the list with the keys 0, step, 2 * step, ... (size keys in total)
+void fill(list_t list, long size, int step)
+{
+    struct Datatype_int data;
+    long i;
+    for (i = 0; i < size; i++) {
+        data.num = i * step;
+        if (dll_insert_at_back(list, &data, &duplicate_datatype_int) == -1)
+            exit(EXIT_FAILURE);
+    }
+}
+
+long keyed_ops(long size)
+{
+    long ops = KEYED_VISITS / size;
+    if (ops > KEYED_OPS)
+        ops = KEYED_OPS;
+    return ops > 0 ? ops : 1;
+}
+
+void bench_insert_back(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    struct Datatype_int data;
+    long i;
+    start();
+    for (i = 0; i < size; i++) {
+        data.num = i;
+        dll_insert_at_back(list, &data, &duplicate_datatype_int);
+    }
+    stop(r, size);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_insert_front(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    struct Datatype_int data;
+    long i;
+    start();
+    for (i = 0; i < size; i++) {
+        data.num = i;
+        dll_insert_at_front(list, &data, &duplicate_datatype_int);
+    }
+    stop(r, size);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_insert_sorted(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    struct Datatype_int data;
+    unsigned int seed = SEED;
+    long i, ops = keyed_ops(size);
+    //even keys in the list, odd keys inserted among them
+    fill(list, size, 2);
+    start();
+    for (i = 0; i < ops; i++) {
+        data.num = 2 * (rand_r(&seed) % size) + 1;
+        dll_insert_sorted(list, &data, &issmaller_int, &duplicate_datatype_int);
+    }
+    stop(r, ops);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_lookup(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    struct Datatype_int data;
+    unsigned int seed = SEED;
+    long i, ops = keyed_ops(size), found = 0;
+    fill(list, size, 1);
+    start();
+    for (i = 0; i < ops; i++) {
+        data.num = rand_r(&seed) % size;
+        if (dll_edit_data(list, &data, &is_equal_int) != NULL)
+            found++;
+    }
+    stop(r, ops);
+    if (found != ops)
+        fprintf(stderr, "lookup: %ld of %ld keys found\n", found, ops);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_lookup_near(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    struct Datatype_int data;
+    unsigned int seed = SEED;
+    long i, ops = keyed_ops(size), found = 0, key = size / 2;
+    fill(list, size, 1);
+    start();
+    //random walk over the keys, a few elements at a time
+    for (i = 0; i < ops; i++) {
+        key += rand_r(&seed) % 9 - 4;
+        if (key < 0 || key >= size)
+            key = size / 2;
+        data.num = key;
+        if (dll_edit_data(list, &data, &is_equal_int) != NULL)
+            found++;
+    }
+    stop(r, ops);
+    if (found != ops)
+        fprintf(stderr, "lookup_near: %ld of %ld keys found\n", found, ops);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_get_at(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    unsigned int seed = SEED;
+    long i, ops = keyed_ops(size), found = 0;
+    fill(list, size, 1);
+    start();
+    for (i = 0; i < ops; i++) {
+        long position = rand_r(&seed) % size;
+        Data_int data = dll_get_at(list, position);
+        if (data != NULL && data->num == position)
+            found++;
+    }
+    stop(r, ops);
+    if (found != ops)
+        fprintf(stderr, "get_at: %ld of %ld positions found\n", found, ops);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_delete(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    struct Datatype_int data;
+    unsigned int seed = SEED;
+    long i, ops = keyed_ops(size), deleted = 0;
+    fill(list, size, 1);
+    //distinct random keys (a partial shuffle of the keys in the list)
+    int* keys = malloc(size * sizeof(int));
+    if (keys == NULL)
+        exit(EXIT_FAILURE);
+    for (i = 0; i < size; i++)
+        keys[i] = i;
+    for (i = 0; i < ops; i++) {
+        long j = i + rand_r(&seed) % (size - i);
+        int key = keys[i];
+        keys[i] = keys[j];
+        keys[j] = key;
+    }
+    start();
+    for (i = 0; i < ops; i++) {
+        data.num = keys[i];
+        if (dll_delete(list, &data, &is_equal_int, &free_datatype_int) == 0)
+            deleted++;
+    }
+    stop(r, ops);
+    if (deleted != ops)
+        fprintf(stderr, "delete: %ld of %ld keys deleted\n", deleted, ops);
+    free(keys);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_delete_front(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    long i;
+    fill(list, size, 1);
+    start();
+    for (i = 0; i < size; i++)
+        dll_delete_front(list, &free_datatype_int);
+    stop(r, size);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_iterate(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    long sum = 0, visited = 0;
+    fill(list, size, 1);
+    start();
+    IteratorID it = dll_iteratorRequest(list);
+    do {
+        Data_int data = dll_iteratorGetObj(list, it);
+        sum += data->num;
+        visited++;
+    } while (dll_iteratorNext(list, it) == 0);
+    dll_iteratorDelete(list, it);
+    stop(r, visited);
+    if (sum != size * (size - 1) / 2)
+        fprintf(stderr, "iterate: wrong sum %ld\n", sum);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void sum_combine(void* acc, void* data)
+{
+    *(long*) acc += ((Data_int) data)->num;
+}
+
+void sum_merge(void* acc, void* partial)
+{
+    *(long*) acc += *(long*) partial;
+}
+
+void bench_reduce(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    long sum = 0;
+    fill(list, size, 1);
+    start();
+    dll_reduce(list, &sum, sizeof(sum), &sum_combine, &sum_merge, nthreads);
+    stop(r, size);
+    if (sum != size * (size - 1) / 2)
+        fprintf(stderr, "reduce: wrong sum %ld\n", sum);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_copy(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind), copy = new_list(kind);
+    fill(list, size, 1);
+    start();
+    dll_copy(list, copy, &duplicate_datatype_int, &free_datatype_int);
+    stop(r, size);
+    dll_destroy(&copy, &free_datatype_int);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_save(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    FILE* file = tmpfile();
+    if (file == NULL)
+        exit(EXIT_FAILURE);
+    fill(list, size, 1);
+    start();
+    if (dll_save(list, fileno(file), &serialize_int) == -1)
+        exit(EXIT_FAILURE);
+    stop(r, size);
+    fclose(file);
+    dll_destroy(&list, &free_datatype_int);
+}
+
+void bench_load(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind), loaded = new_list(kind);
+    FILE* file = tmpfile();
+    if (file == NULL)
+        exit(EXIT_FAILURE);
+    fill(list, size, 1);
+    if (dll_save(list, fileno(file), &serialize_int) == -1 ||
+            lseek(fileno(file), 0, SEEK_SET) == -1)
+        exit(EXIT_FAILURE);
+    dll_destroy(&list, &free_datatype_int);
+    start();
+    if (dll_load(loaded, fileno(file), &deserialize_int,
+            &free_datatype_int) == -1)
+        exit(EXIT_FAILURE);
+    stop(r, size);
+    if (dll_size(loaded) != size)
+        fprintf(stderr, "load: %d of %ld elements loaded\n", dll_size(loaded),
+                size);
+    fclose(file);
+    dll_destroy(&loaded, &free_datatype_int);
+}
+
+// Opening a mapped list costs the same whatever its size, so this times a
+// single dll_map_open, along with a read of the last element
+void bench_map_open(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind), mapped = NULL;
+    char path[] = "/tmp/bench_mapXXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1)
+        exit(EXIT_FAILURE);
+    close(fd);
+    fill(list, size, 1);
+    if (dll_map_save(list, path, sizeof(struct Datatype_int)) == -1)
+        exit(EXIT_FAILURE);
+    dll_destroy(&list, &free_datatype_int);
+    start();
+    if (dll_map_open(&mapped, path) == -1)
+        exit(EXIT_FAILURE);
+    const struct Datatype_int* last = dll_get_back(mapped, NULL, 0);
+    stop(r, 1);
+    if (last == NULL || last->num != size - 1)
+        fprintf(stderr, "map_open: wrong last element\n");
+    dll_destroy(&mapped, NULL);
+    unlink(path);
+}
+
+void bench_destroy(enum kind kind, long size, struct result* r)
+{
+    list_t list = new_list(kind);
+    fill(list, size, 1);
+    start();
+    dll_destroy(&list, &free_datatype_int);
+    stop(r, size);
+}
+
+// Arena lists (whatever the kind asked for) build their elements in the arena
+// of the list being filled, and are destroyed without visiting the nodes
+list_t arena_list = NULL;
+
+void* duplicate_arena(void* data)
+{
+    Data_int copy = dll_arena_alloc(arena_list, sizeof(struct Datatype_int));
+    if (copy != NULL)
+        copy->num = ((Data_int) data)->num;
+    return copy;
+}
+
+void bench_destroy_arena(enum kind kind, long size, struct result* r)
+{
+    struct Datatype_int data;
+    long i;
+    //arena lists are always pooled, whatever kind the scenario asks for
+    (void) kind;
+    if (dll_init_arena(&arena_list, 0) == -1)
+        exit(EXIT_FAILURE);
+    for (i = 0; i < size; i++) {
+        data.num = i;
+        if (dll_insert_at_back(arena_list, &data, &duplicate_arena) == -1)
+            exit(EXIT_FAILURE);
+    }
+    start();
+    dll_destroy(&arena_list, NULL);
+    stop(r, size);
+}
+
+struct scenario
+{
+    const char* name;
+    void (*run)(enum kind, long, struct result*);
+    int bulk;   // times a bulk operation, not available for unrolled lists
+};
+
+struct scenario scenarios[] = {
+    { "insert_back", &bench_insert_back },
+    { "insert_front", &bench_insert_front },
+    { "insert_sorted", &bench_insert_sorted },
+    { "lookup", &bench_lookup },
+    { "lookup_near", &bench_lookup_near },
+    { "get_at", &bench_get_at },
+    { "delete", &bench_delete },
+    { "delete_front", &bench_delete_front },
+    { "iterate", &bench_iterate },
+    { "reduce", &bench_reduce, 1 },
+    { "copy", &bench_copy },
+    { "save", &bench_save },
+    { "load", &bench_load, 1 },
+    { "map_open", &bench_map_open },
+    { "destroy", &bench_destroy },
+    { "destroy_arena", &bench_destroy_arena },
+    { NULL, NULL }
+};
+
+/*
+ * Runs the scenario in a child process and prints its JSON record
+ * Returns 0 on success, -1 on failure
+ */
+int run(struct scenario* s, enum kind kind, long size, int first)
+{
+    int fd[2];
+    if (pipe(fd) == -1) {
+        perror("pipe");
+        return -1;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        struct result r;
+        close(fd[0]);
+        (*s->run)(kind, size, &r);
+        if (write(fd[1], &r, sizeof(r)) != sizeof(r))
+            _exit(EXIT_FAILURE);
+        _exit(EXIT_SUCCESS);
+    }
+    close(fd[1]);
+    struct result r;
+    ssize_t got = read(fd[0], &r, sizeof(r));
+    close(fd[0]);
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) == -1 || got != sizeof(r) ||
+            !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        fprintf(stderr, "%s/%ld: run failed\n", s->name, size);
+        return -1;
+    }
+    printf("%s    {\"scenario\": \"%s\", \"size\": %ld, \"ops\": %ld, "
+            "\"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, "
+            "\"peak_rss_kb\": %ld}", first ? "" : ",\n", s->name, size, r.ops,
+            r.ns / r.ops, (double) r.allocs / r.ops, usage.ru_maxrss);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    enum kind kind = PLAIN;
+    long max_size = 1000000, size;
+    int opt, i, errors = 0, first = 1;
+    while ((opt = getopt(argc, argv, "k:fim:t:")) != -1) {
+        if (opt == 'k' && strcmp(optarg, "plain") == 0)
+            kind = PLAIN;
+        else if (opt == 'k' && strcmp(optarg, "pooled") == 0)
+            kind = POOLED;
+        else if (opt == 'k' && strcmp(optarg, "inline") == 0)
+            kind = INLINE;
+        else if (opt == 'k' && strcmp(optarg, "unrolled") == 0)
+            kind = UNROLLED;
+        else if (opt == 'f')
+            use_finger = 1;
+        else if (opt == 'i')
+            use_index = 1;
+        else if (opt == 'm' && atol(optarg) >= 1000)
+            max_size = atol(optarg);
+        else if (opt == 't' && atoi(optarg) >= 1)
+            nthreads = atoi(optarg);
+        else {
+            fprintf(stderr, "Usage: %s [-k plain|pooled|inline|unrolled] "
+                    "[-f] [-i] [-m max_size] [-t nthreads] [scenario ...]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    //unrolled lists have neither a finger nor a skip index
+    if (kind == UNROLLED && (use_finger || use_index)) {
+        fprintf(stderr, "Usage: %s: -f and -i are not available with "
+                "-k unrolled\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    //check the scenarios asked for
+    for (i = optind; i < argc; i++) {
+        struct scenario* s = scenarios;
+        while (s->name != NULL && strcmp(s->name, argv[i]) != 0)
+            s++;
+        if (s->name == NULL) {
+            fprintf(stderr, "Unknown scenario: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    printf("{\n  \"list\": \"%s\",\n  \"finger\": %s,\n  \"index\": %s,\n"
+            "  \"threads\": %d,\n  \"results\": [\n", kind_names[kind],
+            use_finger ? "true" : "false", use_index ? "true" : "false",
+            nthreads);
+    struct scenario* s;
+    for (s = scenarios; s->name != NULL; s++) {
+        int wanted = (optind == argc);
+        for (i = optind; i < argc; i++)
+            if (strcmp(s->name, argv[i]) == 0)
+                wanted = 1;
+        if (!wanted || (kind == UNROLLED && s->bulk))
+            continue;
+        for (size = 1000; size <= max_size; size *= 10) {
+            if (run(s, kind, size, first) == -1)
+                errors++;
+            else
+                first = 0;
+        }
+    }
+    printf("\n  ]\n}\n");
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -77,3 +77,53 @@ int is_equal_int(void* data, void* key)
     else
         return 0;
 }
+
+
+/*
+ * Function responsible for hashing the element, so that equal elements (as
+ * defined by is_equal_int) get equal hashes
+ * (Bits are mixed with the finalizer of MurmurHash3)
+ */
+unsigned int hash_int(void* data)
+{
+    unsigned int h = (unsigned int) ((Data_int)data)->num;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+
+/*
+ * Function responsible for writing the element into buf (of `size` bytes) for
+ * dll_save, if it fits
+ * Return values:
+ *      [*] The number of bytes the element takes is returned
+ */
+int serialize_int(void* data, void* buf, size_t size)
+{
+    if (size >= sizeof(int))
+        memcpy(buf, &((Data_int)data)->num, sizeof(int));
+    return sizeof(int);
+}
+
+
+/*
+ * Function responsible for building a new element out of the bytes written by
+ * serialize_int, for dll_load
+ * Return values:
+ *      [*] On success, the new element is returned
+ *      [*] On malformed record or on failure, NULL is returned
+ */
+void* deserialize_int(const void* buf, size_t size)
+{
+    if (size != sizeof(int))
+        return NULL;
+    Data_int data = allocate_datatype_int();
+    if (data == NULL)
+        return NULL;
+    memcpy(&data->num, buf, sizeof(int));
+    return data;
+}
@@ -8,6 +8,8 @@
 #ifndef DATA_TYPE_H
 #define	DATA_TYPE_H
 
+#include <stddef.h>
+
 #ifdef	__cplusplus
 extern "C"
 {
@@ -25,6 +27,9 @@ extern "C"
     void print_int(void*);
     int issmaller_int(void*, void*);
     int is_equal_int(void*, void*);
+    unsigned int hash_int(void*);
+    int serialize_int(void*, void*, size_t);
+    void* deserialize_int(const void*, size_t);
 
 #ifdef	__cplusplus
 }
@@ -282,6 +282,60 @@ int main(void) {
         "copying list error");
     printf("\n\nPrinting copied list\n");
     dll_print(newlist, &print_int, 0);
+    printf("===============================================================\n");
+    printf("Testing sort, merge, remove_if, split and splice\n");
+    // a pooled list is merged with a plain one that has a skip index
+    list_t pooled = NULL, indexed = NULL;
+    cneg(dll_init_pooled(&pooled, 0));
+    cneg(dll_init(&indexed));
+    cneg(dll_indexEnable(indexed));
+    int i;
+    for (i = 10; i > 0; i--) {
+        data->num = i * 3;
+        cneg(dll_insert_at_back(pooled, data, &duplicate_datatype_int));
+        data->num = i * 2;
+        cneg(dll_insert_sorted(indexed, data, &issmaller_int,
+            &duplicate_datatype_int));
+    }
+    chneg(dll_sort(pooled, &issmaller_int), "sorting list error\n");
+    dll_print(pooled, &print_int, 1);
+    dll_print(indexed, &print_int, 1);
+    data->num = 14;
+    returned = dll_search_sorted(indexed, data, &issmaller_int);
+    if (returned) {
+        printf("\t\t\tFound through the skip index: ");
+        print_int(returned);
+        printf("\n");
+    }
+    chneg(dll_merge_sorted(pooled, &indexed, &issmaller_int),
+        "merging lists error\n");
+    dll_print(pooled, &print_int, 1);
+    // both lists had a 6, a 12 and an 18
+    data->num = 6;
+    chneg(dll_remove_if(pooled, &is_equal_int, data, &free_datatype_int, NULL),
+        "remove_if error\n");
+    dll_print(pooled, &print_int, 1);
+    // cut the list at its 5th element
+    IteratorID cut = dll_iteratorRequest(pooled);
+    chneg(cut, "iterator request error\n");
+    for (i = 0; i < 4; i++)
+        chneg(dll_iteratorNext(pooled, cut), "iterator next error\n");
+    list_t tail = NULL;
+    chneg(dll_split_at(pooled, cut, &tail), "splitting list error\n");
+    dll_print(pooled, &print_int, 1);
+    dll_print(tail, &print_int, 1);
+    // and move the first two elements of the tail back to the front
+    IteratorID from = dll_iteratorRequest(tail);
+    IteratorID to = dll_iteratorRequest(tail);
+    IteratorID at = dll_iteratorRequest(pooled);
+    if (from < 0 || to < 0 || at < 0)
+        return -1;
+    chneg(dll_iteratorNext(tail, to), "iterator next error\n");
+    chneg(dll_splice(tail, from, to, pooled, at), "splicing lists error\n");
+    dll_print(pooled, &print_int, 1);
+    dll_print(tail, &print_int, 1);
+    dll_destroy(&pooled, &free_datatype_int);
+    dll_destroy(&tail, &free_datatype_int);
     //test deleting all iterators with dll_iteratorDelete
     dll_iteratorDelete(list, iter);
     // Destroy the list    
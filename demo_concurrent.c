@@ -0,0 +1,332 @@
+/*
+ *  Project: Doubly Linked List C-API, concurrent client program example
+ *  File:   demo_concurrent.c
+ *  Author: Chris Aslanoglou
+ *  Github: https://github.com/chris-asl/doubly-linked-list-API
+ *
+ *  Stress test for concurrent lists: threads insert, look up and delete
+ *  elements of their own (interleaved) key ranges in a shared sorted list,
+ *  then push and pop at both ends, and the list invariants are checked
+ *  after every round. The pushes and pops are run on a lock-free deque as
+ *  well. Finally, producer threads feed a list as a queue while as many
+ *  consumer threads drain it, checking that every element comes out once,
+ *  on concurrent lists and lock-free deques (of objects and of inline
+ *  elements) with 1, 2 and 4 threads on each side
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "doubly_linked_list_adt.h"
+#include "datatype_int.h"
+
+#define NTHREADS 8
+#define KEYS 4096
+#define OPS 20000
+#define ROUNDS 4
+
+struct worker
+{
+    list_t list;
+    int id;
+    unsigned int seed;
+    int live;               // elements of this thread in the list
+    char present[KEYS];     // keys of this thread in the list
+    int errors;
+};
+
+void* sorted_worker(void* arg)
+{
+    struct worker* w = arg;
+    struct Datatype_int data;
+    int i;
+    for (i = 0; i < OPS; i++) {
+        //keys of thread `id` are the ones equal to id modulo NTHREADS
+        int key = (rand_r(&w->seed) % (KEYS / NTHREADS)) * NTHREADS + w->id;
+        data.num = key;
+        Data_int found = dll_edit_data(w->list, &data, &is_equal_int);
+        if ((found != NULL) != w->present[key])
+            w->errors++;
+        if (w->present[key]) {
+            if (dll_delete(w->list, &data, &is_equal_int,
+                    &free_datatype_int) != 0)
+                w->errors++;
+            w->present[key] = 0;
+            w->live--;
+        }
+        else {
+            if (dll_insert_sorted(w->list, &data, &issmaller_int,
+                    &duplicate_datatype_int) != 0)
+                w->errors++;
+            w->present[key] = 1;
+            w->live++;
+        }
+    }
+    return NULL;
+}
+
+// Queue round state: elements pushed by the producers (the first
+// `queue_pairs` threads) are numbered, and consumers count how many times
+// each number is popped. Inline lists get copies of the elements in and out
+// instead
+int queue_pairs = NTHREADS / 2;
+int queue_popped = 0;
+int queue_inline = 0;
+int (*queue_push)(list_t, void*) = &dll_adopt_at_back;
+char queue_seen[NTHREADS / 2 * OPS];
+
+void* queue_worker(void* arg)
+{
+    struct worker* w = arg;
+    struct Datatype_int copy;
+    int i;
+    if (w->id < queue_pairs && queue_inline) {
+        //producer, the list keeps a copy of `copy`
+        for (i = 0; i < OPS; i++) {
+            copy.num = w->id * OPS + i;
+            if ((*queue_push)(w->list, &copy) != 0)
+                w->errors++;
+        }
+        return NULL;
+    }
+    if (w->id < queue_pairs) {
+        //producer
+        for (i = 0; i < OPS; i++) {
+            Data_int data = allocate_datatype_int();
+            if (data == NULL) {
+                w->errors++;
+                continue;
+            }
+            data->num = w->id * OPS + i;
+            if ((*queue_push)(w->list, data) != 0)
+                w->errors++;
+        }
+        return NULL;
+    }
+    //consumer, until all the elements have been popped
+    while (__atomic_load_n(&queue_popped, __ATOMIC_RELAXED) <
+            queue_pairs * OPS) {
+        if (queue_inline) {
+            int retval = dll_pop_front_into(w->list, &copy);
+            if (retval == -1)
+                w->errors++;
+            if (retval != 0) {
+                sched_yield();
+                continue;
+            }
+            __atomic_add_fetch(&queue_seen[copy.num], 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&queue_popped, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+        Data_int data = dll_pop_front(w->list);
+        if (data == NULL) {
+            sched_yield();
+            continue;
+        }
+        __atomic_add_fetch(&queue_seen[data->num], 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&queue_popped, 1, __ATOMIC_RELAXED);
+        free_datatype_int(data);
+    }
+    return NULL;
+}
+
+void* deque_worker(void* arg)
+{
+    struct worker* w = arg;
+    struct Datatype_int data;
+    int i;
+    for (i = 0; i < OPS; i++) {
+        data.num = w->id;
+        switch (rand_r(&w->seed) % 4) {
+            case 0:
+                if (dll_insert_at_front(w->list, &data,
+                        &duplicate_datatype_int) != 0)
+                    w->errors++;
+                w->live++;
+                break;
+            case 1:
+                if (dll_insert_at_back(w->list, &data,
+                        &duplicate_datatype_int) != 0)
+                    w->errors++;
+                w->live++;
+                break;
+            case 2: {
+                Data_int popped = dll_pop_front(w->list);
+                if (popped != NULL) {
+                    free_datatype_int(popped);
+                    w->live--;
+                }
+                break;
+            }
+            default: {
+                Data_int popped = dll_pop_back(w->list);
+                if (popped != NULL) {
+                    free_datatype_int(popped);
+                    w->live--;
+                }
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Walks the list both ways with an iterator, checking that both walks see
+ * `expected` elements (in ascending order, if `sorted` is set). Deques,
+ * which have no iterators, only have their size checked
+ * Returns the number of violations found
+ */
+int check_list(list_t list, int expected, int sorted, int deque)
+{
+    int errors = 0, forward = 0, backward = 0;
+    if (dll_size(list) != expected) {
+        fprintf(stderr, "size is %d instead of %d\n", dll_size(list), expected);
+        errors++;
+    }
+    if (expected == 0 || deque)
+        return errors;
+    IteratorID it = dll_iteratorRequest(list);
+    if (it == -1)
+        return errors + 1;
+    Data_int previous = NULL;
+    do {
+        Data_int current = dll_iteratorGetObj(list, it);
+        if (sorted && previous != NULL && issmaller_int(current, previous))
+            errors++;
+        previous = current;
+        forward++;
+    } while (dll_iteratorNext(list, it) == 0);
+    do {
+        backward++;
+    } while (dll_iteratorPrev(list, it) == 0);
+    dll_iteratorDelete(list, it);
+    if (forward != expected || backward != expected) {
+        fprintf(stderr, "walked %d forward and %d backward, expected %d\n",
+                forward, backward, expected);
+        errors++;
+    }
+    return errors;
+}
+
+/*
+ * Runs fn on the first `nthreads` workers and checks the list afterwards
+ * Returns the number of violations found
+ */
+int run(list_t list, struct worker* workers, void* (*fn)(void*), int nthreads,
+        int deque)
+{
+    pthread_t threads[NTHREADS];
+    int i, expected = 0, errors = 0;
+    for (i = 0; i < nthreads; i++)
+        if (pthread_create(&threads[i], NULL, fn, &workers[i]) != 0) {
+            perror("pthread_create");
+            exit(EXIT_FAILURE);
+        }
+    for (i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+        expected += workers[i].live;
+        errors += workers[i].errors;
+    }
+    return errors + check_list(list, expected, fn == sorted_worker, deque);
+}
+
+/*
+ * Runs a queue round with `pairs` producers and as many consumers, on a new
+ * list made by init, printing its throughput
+ * Returns the number of violations found
+ */
+int run_queue(struct worker* workers, const char* kind,
+        int (*init)(list_t*, size_t), size_t elem_size,
+        int (*push)(list_t, void*), int pairs)
+{
+    struct timespec start, end;
+    list_t list = NULL;
+    int i;
+    if ((*init)(&list, elem_size) == -1)
+        return 1;
+    queue_pairs = pairs;
+    queue_inline = (elem_size > 0);
+    queue_push = push;
+    queue_popped = 0;
+    for (i = 0; i < pairs * OPS; i++)
+        queue_seen[i] = 0;
+    for (i = 0; i < 2 * pairs; i++) {
+        workers[i].list = list;
+        workers[i].live = 0;
+        workers[i].errors = 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int e = run(list, workers, &queue_worker, 2 * pairs, init == &dll_init_deque);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    for (i = 0; i < pairs * OPS; i++)
+        if (queue_seen[i] != 1)
+            e++;
+    printf("Queue round (%s), %d producers and %d consumers: %.0f elements/s, "
+            "%d errors\n", kind, pairs, pairs, pairs * OPS /
+            ((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9),
+            e);
+    dll_destroy(&list, queue_inline ? NULL : &free_datatype_int);
+    return e;
+}
+
+int main(void)
+{
+    list_t list = NULL;
+    struct worker workers[NTHREADS];
+    int i, round, pairs, errors = 0;
+    if (dll_init_concurrent(&list, 0) == -1)
+        return EXIT_FAILURE;
+    for (i = 0; i < NTHREADS; i++) {
+        workers[i] = (struct worker) { .list = list, .id = i, .seed = i + 1 };
+    }
+    for (round = 0; round < ROUNDS; round++) {
+        int e = run(list, workers, &sorted_worker, NTHREADS, 0);
+        printf("Round %d, sorted inserts/deletes: %d elements, %d errors\n",
+                round, dll_size(list), e);
+        errors += e;
+    }
+    //empty the list before the deque rounds
+    while (dll_size(list) > 0)
+        dll_delete_front(list, &free_datatype_int);
+    for (i = 0; i < NTHREADS; i++)
+        workers[i].live = 0;
+    for (round = 0; round < ROUNDS; round++) {
+        int e = run(list, workers, &deque_worker, NTHREADS, 0);
+        printf("Round %d, pushes/pops at both ends: %d elements, %d errors\n",
+                round, dll_size(list), e);
+        errors += e;
+    }
+    dll_destroy(&list, &free_datatype_int);
+    //the same rounds on a lock-free deque
+    if (dll_init_deque(&list, 0) == -1)
+        return EXIT_FAILURE;
+    for (i = 0; i < NTHREADS; i++) {
+        workers[i].list = list;
+        workers[i].live = 0;
+    }
+    for (round = 0; round < ROUNDS; round++) {
+        int e = run(list, workers, &deque_worker, NTHREADS, 1);
+        printf("Round %d, lock-free pushes/pops at both ends: %d elements, "
+                "%d errors\n", round, dll_size(list), e);
+        errors += e;
+    }
+    dll_destroy(&list, &free_datatype_int);
+    //queue rounds, with more and more threads on each side
+    for (pairs = 1; pairs <= NTHREADS / 2; pairs *= 2) {
+        errors += run_queue(workers, "concurrent list", &dll_init_concurrent,
+                0, &dll_adopt_at_back, pairs);
+        errors += run_queue(workers, "concurrent inline list",
+                &dll_init_concurrent, sizeof(struct Datatype_int),
+                &dll_adopt_at_back, pairs);
+        errors += run_queue(workers, "lock-free deque", &dll_init_deque, 0,
+                &dll_push_back, pairs);
+        errors += run_queue(workers, "lock-free inline deque",
+                &dll_init_deque, sizeof(struct Datatype_int), &dll_push_back,
+                pairs);
+    }
+    printf(errors == 0 ? "All checks passed\n" : "Checks FAILED\n");
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -10,24 +10,306 @@
 #include <stdlib.h>
 #include <string.h>
 #include <locale.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "../ReadWriteLock/rwlock.h"
 #include "doubly_linked_list_adt.h"
 
+// Default number of nodes carved out of every pool chunk
+#define DLL_POOL_CHUNK_NODES 256
+// Default number of elements held by the nodes of unrolled lists
+#define DLL_UNROLLED_NODE_ELEMS 16
+// Size of the payload blocks of arena lists (see dll_arena_alloc), in bytes
+#define DLL_ARENA_BLOCK (1 << 16)
+// Number of bins of the merge sort (lists of up to 2^64 nodes)
+#define DLL_SORT_BINS 64
+// Positions for dll_syncInsertAt
+#define DLL_SYNC_BEFORE 0
+#define DLL_SYNC_AFTER 1
+#define DLL_SYNC_SORTED 2
+// Iterator IDs: bits of the slot index, highest slot generation (so that IDs
+// stay positive, generations wrap around to 0 past it) and marker of slots in
+// use
+#define DLL_ITER_SLOT_BITS 16
+#define DLL_ITER_MAX_GENERATION ((1 << (31 - DLL_ITER_SLOT_BITS)) - 1)
+#define DLL_ITER_LIVE -2
+// Maximum number of levels of the skip index (towers on 1/4 of the nodes
+// at every level, enough for 4^16 nodes)
+#define DLL_INDEX_MAX_LEVEL 16
+// Snapshots (see dll_save): magic number ("DLL1"), size of the I/O buffers
+// and number of elements inserted at once by dll_load
+#define DLL_SNAPSHOT_MAGIC 0x444c4c31u
+#define DLL_IO_BUFFER (1 << 18)
+#define DLL_LOAD_BATCH 1024
+// Magic number of the files of mapped lists ("DLM1", see dll_map_save)
+#define DLL_MAP_MAGIC 0x444c4d31u
+// Ends of lock-free deques (see dll_dequeInsert) and status of their anchor
+// when no push is pending (a push pending at an end is that end plus 1)
+#define DLL_DEQUE_FRONT 0
+#define DLL_DEQUE_BACK 1
+#define DLL_DEQUE_STABLE 0
+#define DLL_DEQUE_STATUS 3
+// Hazard pointers per thread, and initial number of nodes a thread retires
+// before it looks for the ones that can be freed
+#define DLL_HAZARDS 2
+#define DLL_HAZARD_RETIRED 64
+// Operation statistics (see dll_stats) are only kept when compiled with
+// -DDLL_STATS, otherwise the macros below expand to nothing (or to the plain
+// mutex calls). Counters of concurrent lists and deques are updated atomically
+#ifdef DLL_STATS
+#define DLL_STAT(list, counter, n) \
+    ((list)->sync != NULL || (list)->deque != NULL \
+        ? (void) __atomic_add_fetch(&(list)->stats.counter, (n), \
+                __ATOMIC_RELAXED) \
+        : (void) ((list)->stats.counter += (n)))
+#define DLL_STAT_PEAK(list) dll_statsPeak(list)
+#define DLL_LOCK(list, mutex) dll_statsLock(list, mutex)
+#define DLL_TRYLOCK(list, mutex) dll_statsTrylock(list, mutex)
+#else
+#define DLL_STAT(list, counter, n) ((void) 0)
+#define DLL_STAT_PEAK(list) ((void) 0)
+#define DLL_LOCK(list, mutex) pthread_mutex_lock(mutex)
+#define DLL_TRYLOCK(list, mutex) pthread_mutex_trylock(mutex)
+#endif
+
 
 // Node type definition
 typedef struct DoublyLinkedListNode *dllnodeptr;
+typedef struct DoublyLinkedListTower *dlltowerptr;
 struct DoublyLinkedListNode
 {
     dllnodeptr previous, next;
     void* data;
+    dlltowerptr tower;  // skip index tower of the node, if it has one
+    int iterators;      // first iterator slot pointing to the node, -1 if none
+    void* payload[];    // element storage of inline lists (data points here),
+                        // pointer-aligned
+};
+
+// Skip index type definitions
+// A random subset of the nodes carries towers, which are linked level by level
+// in list order, so that searches can skip over long runs of the node chain.
+// Every link also counts the nodes it skips over, so that positions can be
+// looked up the same way
+struct DoublyLinkedListTower
+{
+    dllnodeptr node;    // NULL for the header tower
+    int height;
+    struct {
+        dlltowerptr previous, next;
+        int span;       // nodes after this one, up to the next tower included
+                        // (up to the tail if there is no next tower)
+    } links[];
+};
+
+typedef struct DoublyLinkedListIndex *dllindexptr;
+struct DoublyLinkedListIndex
+{
+    dlltowerptr header;
+    unsigned int seed;
+};
+
+// Hash index type definitions
+// Open addressing (linear probing) table of nodes, keyed by the hash of their
+// data, which is kept alongside so that probing rarely touches the nodes
+typedef struct DoublyLinkedListHashSlot dllhashslot;
+struct DoublyLinkedListHashSlot
+{
+    dllnodeptr node;    // NULL for empty slots
+    unsigned int hash;
+};
+
+typedef struct DoublyLinkedListHash *dllhashptr;
+struct DoublyLinkedListHash
+{
+    dllhashslot *slots;
+    unsigned int capacity;  // always a power of 2
+    unsigned int count;
+    unsigned int (*hash)(void*);
+};
+
+// Node pool type definitions
+// Nodes are carved sequentially out of big chunks, while released nodes are
+// kept in a free list (linked through their first pointer) for reuse
+typedef struct DoublyLinkedListPoolChunk *dllchunkptr;
+struct DoublyLinkedListPoolChunk
+{
+    dllchunkptr next;
+    int capacity;
+    void* nodes[];      // pointer-aligned storage for the nodes
+};
+
+typedef struct DoublyLinkedListPool *dllpoolptr;
+struct DoublyLinkedListPool
+{
+    dllchunkptr first, current;
+    int used;
+    int chunk_nodes;
+    size_t node_size;
+    void* free_list;
+};
+
+// Arena type definition
+// Storage handed out by dll_arena_alloc is carved sequentially out of big
+// blocks, and never given back on its own: the blocks are only freed all at
+// once, when the list is cleared or destroyed
+typedef struct DoublyLinkedListArenaBlock *dllblockptr;
+struct DoublyLinkedListArenaBlock
+{
+    dllblockptr next;
+    size_t capacity, used;
+    void* bytes[];      // pointer-aligned storage
+};
+
+// Snapshot I/O type definition
+// Buffer of dll_save and dll_load, written (or read) with large sequential
+// system calls. Bytes from `start` to `end` are pending
+typedef struct DoublyLinkedListIOBuffer dllio;
+struct DoublyLinkedListIOBuffer
+{
+    int fd;
+    char* buffer;
+    size_t capacity;
+    size_t start, end;
+};
+
+// Mapped list type definitions
+// Files written by dll_map_save (and mapped by dll_map_open) hold a header
+// followed by the nodes, in list order. Nodes link to each other with their
+// offsets from the start of the file (0 standing for none) instead of
+// pointers, so that the file means the same wherever it is mapped, and hold
+// their element inline. Mapped lists keep their head and tail NULL: their
+// nodes are found by position (see dll_mapNodeAt) and never mixed up with the
+// nodes of the other lists
+typedef struct DoublyLinkedListMapHeader dllmapheader;
+struct DoublyLinkedListMapHeader
+{
+    uint32_t magic;
+    uint32_t elem_size;
+    uint64_t count;
+    uint64_t node_size;
+    uint64_t head, tail;    // offsets of the ends of the list, 0 if empty
+};
+
+typedef struct DoublyLinkedListMapNode *dllmapnodeptr;
+struct DoublyLinkedListMapNode
+{
+    uint64_t previous, next;
+    uint64_t payload[];     // element, padded to a multiple of 8 bytes
+};
+
+// Unrolled mode type definitions
+// Unrolled lists (dll_init_unrolled) keep their elements in arrays of up to
+// `node_elems` pointers per node, so that scans visit one node per run of
+// elements instead of one node per element. A full node is split in two
+// halves when an element is added to it, while a node left less than half full
+// by a delete is merged with a neighbour, if their elements fit in one node.
+// Nodes come out of the node pool of the list
+typedef struct DoublyLinkedListUnrolledNode *dllunodeptr;
+struct DoublyLinkedListUnrolledNode
+{
+    dllunodeptr previous, next;
+    int count;          // elements held, never 0
+    int iterators;      // first iterator slot pointing into the node, -1 if
+                        // none
+    void* items[];      // the elements, in list order
+};
+
+typedef struct DoublyLinkedListUnrolled *dllunrolledptr;
+struct DoublyLinkedListUnrolled
+{
+    dllunodeptr head, tail;
+    int node_elems;     // capacity of the nodes
+};
+
+// Concurrent mode type definition
+// Every node carries a mutex of its own (placed after the node and its
+// payload) and the two ends of the list have one each. A link is changed only
+// while holding the mutexes of both nodes it connects (the head or tail mutex
+// standing in for a missing node), and mutexes are always taken in list order:
+// head mutex, nodes from head to tail, tail mutex. Out of order acquisitions
+// use trylock and back off
+typedef struct DoublyLinkedListSync *dllsyncptr;
+struct DoublyLinkedListSync
+{
+    pthread_mutex_t head, tail;
+    pthread_mutex_t iterators;  // guards the iterators array
+    size_t node_lock;           // offset of the node mutex inside the nodes
+};
+
+// Lock-free deque type definitions
+// Deque lists (dll_init_deque) follow the CAS-based deque of M. M. Michael
+// (Euro-Par 2003). Both ends of the list live in one anchor, swapped as a
+// whole with a double-width compare-and-swap, along with a status telling
+// whether the node just pushed at an end is still to be linked from its
+// neighbour. Threads finding a push pending complete it (see
+// dll_dequeStabilize) before trying their own operation, so no thread ever
+// waits on another. Nodes are the usual ones (`previous` towards the front,
+// `next` towards the back) and popped nodes are reclaimed with hazard
+// pointers: a node is only freed once no thread publishes it in one
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+typedef union DoublyLinkedListAnchor dllanchor;
+union DoublyLinkedListAnchor
+{
+    uintptr_t ends[2];          // front and back nodes, the status in the low
+                                // bits of the back one
+    unsigned __int128 word;     // both ends at once
+};
+#endif
+
+typedef struct DoublyLinkedListDeque *dlldequeptr;
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+struct DoublyLinkedListDeque
+{
+    dllanchor anchor;
+};
+#endif
+
+// Hazard pointer records, one per thread popping from or pushing to deques,
+// kept on a global list and handed over to a new thread once their own
+// thread exits. Nodes popped by the thread wait in `retired` until no record
+// publishes them
+typedef struct DoublyLinkedListHazards *dllhazardsptr;
+struct DoublyLinkedListHazards
+{
+    dllnodeptr hazards[DLL_HAZARDS];
+    int active;             // taken by a thread, updated atomically
+    dllhazardsptr next;
+    dllnodeptr* retired;
+    int retiredCount, retiredCapacity;
 };
 
+// Hazard pointer records of all the threads, and the key of the record of the
+// calling thread (created once, see dll_hazardKeyCreate)
+dllhazardsptr dll_hazardRecords = NULL;
+pthread_key_t dll_hazardKey;
+pthread_once_t dll_hazardOnce = PTHREAD_ONCE_INIT;
+int dll_hazardKeyError = 0;
+
 // Iterator type definition
+// Iterators live in a slot map: an IteratorID holds the index of its slot in
+// the low DLL_ITER_SLOT_BITS bits and the generation of the slot above them.
+// The generation is bumped whenever the slot is freed, so that stale IDs
+// never match a reused slot
 typedef struct DoublyLinkedListIterator dlliterator;
 struct DoublyLinkedListIterator
 {
     dllnodeptr node;
-    IteratorID id;
+    dllmapnodeptr mapped;   // node of mapped lists (node is NULL for them),
+                            // which is not tracked as they never change
+    dllunodeptr unode;      // node and offset of the element in unrolled
+    int offset;             // lists (node is NULL for them as well)
+    int generation;
+    int next_free;      // next free slot, DLL_ITER_LIVE for slots in use
+    // neighbouring slots in the list of iterators of the same node
+    int previous_on_node, next_on_node;
 };
 
 // DLL ADT definition
@@ -35,10 +317,33 @@ struct DoublyLinkedList_ADT
 {
     dllnodeptr head, tail;
     int size;
-    dlliterator *iteratorsArray;
-    int iteratorsCount;
-    IteratorID id_counter;
+    dlliterator *iteratorsArray;    // iterator slots
+    int iteratorsCount;             // slots in use, updated atomically
+    int iteratorsCapacity;
+    int iteratorsFree;              // first free slot, -1 if there is none
     ReadWriteLock lock;
+    dllpoolptr pool;
+    dllblockptr arena;  // blocks of storage handed out by dll_arena_alloc (the
+                        // one in use first), along with the ones adopted
+    size_t arena_block; // size of those blocks, 0 for lists that are not
+                        // arena lists (dll_init_arena)
+    size_t elem_size;   // size of inline payloads, 0 for duplicated elements
+    size_t node_size;
+    dllindexptr index;
+    dllhashptr hash;
+    int use_finger;     // keyed searches start at the finger (dll_fingerEnable)
+    dllnodeptr finger;  // node found by the last keyed search, if any
+    dllsyncptr sync;    // concurrent mode state, NULL for plain lists
+    dllunrolledptr unrolled;    // unrolled mode state (dll_init_unrolled),
+                                // NULL for the other lists
+    dlldequeptr deque;  // lock-free deque state (dll_init_deque), NULL for the
+                        // other lists
+    char* map;          // file mapping of read-only lists (dll_map_open),
+                        // NULL for the others
+    size_t map_length;
+#ifdef DLL_STATS
+    struct dll_stats stats;
+#endif
 };
 
 // Forward declaration of non API functions
@@ -51,1381 +356,6828 @@ struct DoublyLinkedList_ADT
  */
 void dll_iteratorUpdate(list_t, dllnodeptr, dllnodeptr);
 /*
-  * Given an IteratorID this function returns the index of the array
-  * in which the Iterator is located (using binary search)
-  * Return values:
-  *     [*] On success, the index is returned
-  *     [*] On element not found, -1 is returned
-  */
- int dll_iteratorGetIdxWithID(list_t, IteratorID);
- /*
-  * Given a dllnodeptr this function returns the index of the array
-  * in which the Iterator is located (using linear search)
-  * Return values:
-  *     [*] On success, the index is returned
-  *     [*] On element not found, -1 is returned
-  */
- int dll_iteratorGetIdxWithPtr(list_t, dllnodeptr);
-
-  int dll_iteratorBinarySearch(list_t, IteratorID, int, int);
-
+ * Given an IteratorID this function returns the slot of the Iterator, in O(1)
+ * Return values:
+ *     [*] On success, the slot is returned
+ *     [*] On stale or unknown ID, NULL is returned
+ */
+dlliterator* dll_iteratorSlot(list_t, IteratorID);
 /*
- * Function responsible for initializing the Doubly Linked List ADT
+ * Frees the slot of an iterator, bumping its generation (which wraps around
+ * past DLL_ITER_MAX_GENERATION)
+ */
+void dll_iteratorRelease(list_t, int);
+/*
+ * Points the iterator to the node, moving it from the list of iterators of
+ * the node it pointed to, to the list of iterators of the new one
+ */
+void dll_iteratorMove(list_t, dlliterator*, dllnodeptr);
+/*
+ * Points the iterator of an unrolled list to the element at the given offset
+ * of the node, moving it to the list of iterators of the node if need be
+ */
+void dll_iteratorPlace(list_t, dlliterator*, dllunodeptr, int);
+/*
+ * Takes the iterator out of the list of iterators of its node
+ */
+void dll_iteratorDetach(list_t, dlliterator*);
+/*
+ * Frees the iterator slots of the list, for good
+ */
+void dll_iteratorsFree(list_t);
+/*
+ * Points the iterators of a detached list of iterators of the same node (the
+ * slots of its two ends given) to the node, in front of its own iterators
+ */
+void dll_iteratorsAttach(list_t, int, int, dllnodeptr);
+/*
+ * Hands the iterators of the node (in `list a`) over to `list b`, whose slot
+ * array must be at least as large: every iterator takes the slot of the same
+ * index in `list b`, keeping its generation (and so its ID), while its slot in
+ * `list a` is released. The free slots of `list b` are left for the caller to
+ * chain
+ */
+void dll_iteratorsMigrate(list_t, dllnodeptr, list_t);
+/*
+ * Returns a new (uninitialized) node, taken from the node pool of the list
+ * if it has one, or allocated with malloc otherwise
  * Return values:
- *      [*] On success,  0 is returned
- *      [*] On failure,  -1 is returned
+ *     [*] On success, the node is returned
+ *     [*] On failure, NULL is returned (errno is set by malloc)
  */
-int dll_init(list_t *listptr_addr)
-{
-    (*listptr_addr) = malloc(sizeof(struct DoublyLinkedList_ADT));
-    if ((*listptr_addr) == NULL) {
-        perror("dll_init - Error initializing DoublyLinkedList ADT");
-        return -1;
-    }
-    if (rwl_init(&((*listptr_addr)->lock)) == -1)
-    {
-        free(*listptr_addr);
-        return -1;
-    }
-    (*listptr_addr)->head = NULL;
-    (*listptr_addr)->tail = NULL;
-    (*listptr_addr)->size = 0;
-    (*listptr_addr)->iteratorsArray = NULL;
-    (*listptr_addr)->iteratorsCount = 0;
-    (*listptr_addr)->id_counter = 0;
-    return 0;
-}
-
-
+dllnodeptr dll_nodeAllocate(list_t);
 /*
- * Function returning the size of the list
+ * Gives back a node obtained with dll_nodeAllocate, either to the free list
+ * of the node pool or to free
  */
-int dll_size(list_t list)
-{
-    int size = 0;
-    rwl_readLock(list->lock);
-    size = list->size;
-    rwl_readUnlock(list->lock);
-    return size;
-}
-
+void dll_nodeRelease(list_t, dllnodeptr);
 /*
- * Function responsible for checking if the list is empty
+ * Returns `count` contiguous (uninitialized) nodes carved out of a single
+ * chunk of the node pool of the list, which must be pooled
  * Return values:
- *      [*] on empty list, 1 is returned
- *      [*] on non empty list, 0 is returned
+ *     [*] On success, the first node is returned
+ *     [*] On failure, NULL is returned
  */
-int dll_isempty(list_t list)
-{//is threadsafe because it uses dll_size()
-    if (list == NULL) {
-        fprintf(stderr, "dll_isempty - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    if (dll_size(list) == 0)
-        return 1;
-    else
-        return 0;
-}
-
-
+dllnodeptr dll_nodeAllocateMany(list_t, int);
 /*
- * Function responsible for printing the list in this fashion:
- *          "element -> element -> element" (delimiter "->")
+ * Builds a detached chain of `count` new nodes holding the given items (in
+ * that order), linked through previous/next. The last node is stored in the
+ * 5th argument
  * Return values:
- *      [*] On success,  0 is returned
- *      [*] On failure,  -1 is returned
+ *     [*] On success, the first node of the chain is returned
+ *     [*] On failure, NULL is returned and nothing is left allocated
  */
-void dll_print(const list_t list, void (*print_data)(void* data),
-        int print_inline)
-{
-    if (list == NULL) {
-        fprintf(stderr, "dll_print - Error: DLList has not been initialized\n");
-        return;
-    }
-    rwl_readLock(list->lock);
-    if (dll_isempty(list)) {
-        printf("List is empty\n");
-
-    }
-    else {
-        printf("=======Printing list======\n");
-        printf("List size: %d\n", list->size);
-        dllnodeptr current = list->head;
-        while (current != list->tail) {
-            if (print_inline) {
-                (*print_data)(current->data);
-                printf(" -> ");
-            }
-            else {
-                printf(" -> ");
-                (*print_data)(current->data);
-                putchar('\n');
-
-            }
-            current = current->next;
-        }
-        //print tail element
-        if (print_inline)
-            (*print_data)(current->data);
-        else {
-            printf(" -> ");
-            (*print_data)(current->data);
-        }
-
-        printf("\n====Done printing list====\n");
-    }
-    rwl_readUnlock(list->lock);
-    return;
-}
-
-
+dllnodeptr dll_chainBuild(list_t, void**, int, void* (*)(void*), dllnodeptr*);
 /*
- * Function responsible for inserting an element at the end of the list
- * The 2nd and 3rd arguments are to be used in conjuction, as the data parameter
- * acts as a dummy object which is going to be duplicated as a new object of the
- * data member of the list node struct.
- * The duplicate function is responsible for allocating a new object and
- * assigning the values of source to destination.
+ * Allocates a node pool whose chunks hold `chunk_nodes` nodes each
  * Return values:
- *      [*] On success,  0 is returned
- *      [*] On failure,  -1 is returned
+ *     [*] On success, the pool is returned
+ *     [*] On failure, NULL is returned
  */
-int dll_insert_at_back(list_t list, void* data, void* (*duplicate)(void*))
-{
-    // Safety checks firstly
-    // 1. Dllist must be initialized
-    if (list == NULL) {
-        fprintf(stderr, "dll_insert_at_back - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // 2. Data must not be NULL
-    if (data == NULL) {
-        fprintf(stderr, "dll_insert_at_back - Error: Data given is NULL\n");
-        return -1;
-    }
-    rwl_writeLock(list->lock);
-    if (list->size == 0) { // changed from dll_isempty() that to avoid deadlock
-        dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-        if (elem == NULL) {
-            perror("dll_insert_at_back - Empty list case, error: ");
-            rwl_writeUnlock(list->lock);
-            return -1;
-        }
-        list->head = elem;
-        list->tail = elem;
-        list->size++;
-        elem->next = NULL;
-        elem->previous = NULL;
-        elem->data = (*duplicate)(data);
-    }
-    else {
-        dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-        if (elem == NULL) {
-            perror("dll_insert_at_back - Error: ");
-            rwl_writeUnlock(list->lock);
-            return -1;
-        }
-        (list->tail)->next = elem;
-        elem->previous = list->tail;
-        list->tail = elem;
-        list->size++;
-        elem->next = NULL;
-        elem->data = (*duplicate)(data);
-    }
-    rwl_writeUnlock(list->lock);
-    return 0;
-}
-
-
+dllpoolptr dll_poolCreate(int, size_t);
 /*
- * Function responsible for inserting an element at the start of the list
- * The 2nd and 3rd arguments are to be used in conjuction, as the data parameter
- * acts as a dummy object which is going to be duplicated as a new object of the
- * data member of the list node struct.
- * The duplicate function is responsible for allocating a new object and
- * assigning the values of source to destination.
+ * Allocates a chunk of `capacity` nodes, which becomes the one that nodes
+ * are carved out of (whatever is left in the previous one stays unused)
  * Return values:
- *      [*] On success,  0 is returned
- *      [*] On failure,  -1 is returned
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned
  */
-int dll_insert_at_front(list_t list, void* data, void* (*duplicate)(void*))
-{
-    // Safety checks firstly
-    // 1. Dllist must be initialized
-    if (list == NULL) {
-        fprintf(stderr, "dll_insert_at_front - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // 2. Data must not be NULL
-    if (data == NULL) {
-        fprintf(stderr, "dll_insert_at_front - Error: Data given is NULL\n");
-        return -1;
-    }
-    rwl_writeLock(list->lock);
-    if (list->size == 0) {      //changed from dll_isempty() to avoid deadlock
-        dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-        if (elem == NULL) {
-            perror("dll_insert_at_front - Empty list case, error: ");
-            rwl_writeUnlock(list->lock);
-            return -1;
-        }
-        list->head = elem;
-        list->tail = elem;
-        list->size++;
-        elem->next = NULL;
-        elem->previous = NULL;
-        elem->data = (*duplicate)(data);
-    }
-    else {
-        dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-        if (elem == NULL) {
-            perror("dll_insert_at_front - Error: ");
-            rwl_writeUnlock(list->lock);
-            return -1;
-        }
-        (list->head)->previous = elem;
-        elem->next = list->head;
-        list->head = elem;
+int dll_poolGrow(dllpoolptr, int);
+/*
+ * Returns `node_size` bytes of (uninitialized) storage out of the pool: a
+ * released node if there is one, or the next node of the current chunk
+ * Return values:
+ *     [*] On success, the storage is returned
+ *     [*] On failure, NULL is returned
+ */
+void* dll_poolAllocate(dllpoolptr);
+/*
+ * Gives back storage obtained with dll_poolAllocate to the free list
+ */
+void dll_poolRelease(dllpoolptr, void*);
+/*
+ * Frees every chunk of the pool along with the pool itself
+ */
+void dll_poolDestroy(dllpoolptr);
+/*
+ * Frees every chunk of the pool, which is left empty for further use
+ */
+void dll_poolReset(dllpoolptr);
+/*
+ * Frees the blocks of storage handed out by dll_arena_alloc
+ */
+void dll_arenaFree(list_t);
+/*
+ * Moves the blocks of storage handed out by dll_arena_alloc of `list b` to
+ * `list a`, behind the block that `list a` is using
+ */
+void dll_arenaAdopt(list_t, list_t);
+/*
+ * Deletes all the nodes of the list and frees their elements with free_data,
+ * leaving the iterators and the indexes to the caller. The nodes of pooled
+ * lists are only visited if their elements need freeing, and are released
+ * along with the chunks of the pool, as are the blocks of arena lists
+ */
+void dll_nodesClear(list_t, void (*)(void*));
+/*
+ * Moves all the nodes of `list b` to the storage of `list a`, so that they
+ * can be released by `list a` later on. Pool chunks are handed over as a
+ * whole when both lists are pooled, otherwise nodes are relocated one by one
+ * The iterators and the indexes of `list b` are deleted, once nothing can
+ * fail anymore
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (list b is left intact)
+ */
+int dll_nodesAdopt(list_t, list_t);
+/*
+ * Moves the `count` nodes from `first` to `last` (a range of `list a`) in
+ * front of `before` in `list b` (to its back, for NULL) by relinking them.
+ * Iterators of `list a` on the range move on as if the nodes were deleted,
+ * unless the last argument is set: then they migrate to `list b` along with
+ * their nodes (see dll_iteratorsMigrate; the ones of `first` are handed over
+ * upfront, so that the range is not walked for them if they are the only
+ * ones). The finger and the indexes of both lists are kept up to date. Nodes
+ * are relocated to the storage of `list b` when either list is pooled
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (both lists are left intact)
+ */
+int dll_nodesMove(list_t, dllnodeptr, dllnodeptr, int, list_t, dllnodeptr,
+        int);
+/*
+ * Gives towers to the nodes from `first` to `last` (a range already linked in
+ * the list) with the usual skip list probabilities and links them into the
+ * skip index of the list, if it has one
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (the index is dropped)
+ */
+int dll_indexLink(list_t, dllnodeptr, dllnodeptr);
+/*
+ * Takes the node (still pointing to its former previous node) out of the skip
+ * index of the list, unlinking and freeing its tower if it has one
+ */
+void dll_indexUnlink(list_t, dllnodeptr);
+/*
+ * Fills the 3rd argument with the last tower of every level that lies before
+ * the node following `previous` (the header for none, and `previous` being
+ * NULL for the head), and the 4th one with their distances from that node
+ */
+void dll_indexPreds(list_t, dllnodeptr, dlltowerptr*, int*);
+/*
+ * Descends the skip index of the list to the node at the given position
+ * (0 for the head), counting the nodes skipped by the links
+ */
+dllnodeptr dll_indexNodeAt(list_t, int);
+/*
+ * Returns the node at the given position (0 for the head), which must be in
+ * range: through the skip index if the list has one, or by walking from the
+ * nearer end of the list otherwise
+ */
+dllnodeptr dll_nodeAt(list_t, int);
+/*
+ * Descends the skip index of the (sorted) list and returns the last node with
+ * a tower that is smaller than `data` (or smaller or equal, if the 4th
+ * argument is true), or NULL if there is none, in which case the search
+ * should start at the head
+ */
+dllnodeptr dll_indexSeek(list_t, void*, int (*)(void*, void*), int);
+/*
+ * Frees all the towers of the skip index along with the index itself
+ */
+void dll_indexDestroy(list_t);
+/*
+ * Allocates a tower of `height` levels for the node (NULL for the header)
+ * Return values:
+ *     [*] On success, the tower is returned
+ *     [*] On failure, NULL is returned
+ */
+dlltowerptr dll_towerCreate(dllnodeptr, int);
+/*
+ * Registers the nodes from `first` to `last` (a range just linked in the list)
+ * with the indexes of the list (skip index and hash index)
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (the failing index is dropped)
+ */
+int dll_nodesIndex(list_t, dllnodeptr, dllnodeptr);
+/*
+ * Returns the node that holds the element identified by `key`: through the
+ * hash index if the list has one, by searching outward from the finger if it
+ * is enabled, or by scanning from the head otherwise
+ * Return values:
+ *     [*] On success, the node is returned
+ *     [*] On element not found, NULL is returned
+ */
+dllnodeptr dll_nodeFind(list_t, void*, int (*)(void*, void*));
+/*
+ * Adds the node to the hash index of the list
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (the hash index is dropped)
+ */
+int dll_hashInsert(list_t, dllnodeptr);
+/*
+ * Removes the node from the hash index of the list
+ */
+void dll_hashRemove(list_t, dllnodeptr);
+/*
+ * Rebuilds the hash table with `capacity` slots (a power of 2)
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (the table is left as it was)
+ */
+int dll_hashResize(dllhashptr, unsigned int);
+/*
+ * Frees the hash index of the list
+ */
+void dll_hashDestroy(list_t);
+/*
+ * Merges two sorted chains of nodes (linked through next, NULL-terminated)
+ * into one, keeping the elements of the 1st chain first among equal ones
+ * Only the next pointers are set
+ * Return values:
+ *     [*] The first node of the merged chain is returned
+ */
+dllnodeptr dll_chainMerge(dllnodeptr, dllnodeptr, int (*)(void*, void*));
+/*
+ * Sorts a chain of nodes (linked through next, NULL-terminated) with a
+ * stable bottom-up merge sort. Only the next pointers are set
+ * Return values:
+ *     [*] The first node of the sorted chain is returned
+ */
+dllnodeptr dll_chainSort(dllnodeptr, int (*)(void*, void*));
+/*
+ * Makes the chain starting at `first` (linked through next) the contents of
+ * the list: sets the previous pointers, the head and the tail
+ */
+void dll_chainRelink(list_t, dllnodeptr);
+/*
+ * Runs the worker on each of the `count` argument structs of `argsize` bytes,
+ * one thread per struct (the calling thread takes the first one), and waits
+ * for all of them. Structs whose thread cannot be created are run by the
+ * calling thread
+ */
+void dll_runParallel(void* (*)(void*), void*, size_t, int);
+/*
+ * Writes the pending bytes of the buffer to its file, retrying short writes
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (errno is set by write)
+ */
+int dll_ioFlush(dllio*);
+/*
+ * Makes room for `size` more bytes at the end of the buffer, flushing it
+ * (and growing it, if it is too small) when needed
+ * Return values:
+ *     [*] On success, a pointer to the room is returned
+ *     [*] On failure, NULL is returned
+ */
+char* dll_ioReserve(dllio*, size_t);
+/*
+ * Consumes the next `size` bytes of the file, reading them into the buffer
+ * in large blocks (and growing it, if it is too small) when needed
+ * Return values:
+ *     [*] On success, a pointer to the bytes in the buffer is returned
+ *     [*] On failure or on end of file, NULL is returned
+ */
+char* dll_ioTake(dllio*, size_t);
+/*
+ * Turns the (empty, unpooled) list into a concurrent one, extending its nodes
+ * with a mutex
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned
+ */
+int dll_syncCreate(list_t);
+/*
+ * Frees the concurrent mode state of the list, if there is one
+ */
+void dll_syncDestroy(list_t);
+/*
+ * Returns the mutex of the node, or `end` (the head or tail mutex) if the
+ * node is NULL
+ */
+pthread_mutex_t* dll_syncMutex(list_t, dllnodeptr, pthread_mutex_t*);
+/*
+ * Walks the concurrent list hand over hand from the head, up to the first
+ * node for which stop(key, data) is true. That node is returned locked, along
+ * with its previous node (NULL standing for the head mutex), locked as well
+ * and stored in the 4th argument. If there is no such node, NULL is returned
+ * and the 4th argument holds the (locked) last node
+ */
+dllnodeptr dll_syncSeek(list_t, void*, int (*)(void*, void*), dllnodeptr*);
+/*
+ * Locks the tail mutex of the concurrent list along with its last node, which
+ * is returned (NULL if the list is empty)
+ */
+dllnodeptr dll_syncLockBack(list_t);
+/*
+ * Links the node between `previous` and `next` (NULL standing for the ends of
+ * the list), whose mutexes must be held
+ */
+void dll_syncLink(list_t, dllnodeptr, dllnodeptr, dllnodeptr);
+/*
+ * Unlinks the node from the list, moving the iterators that point to it.
+ * The mutexes of the node and both of its neighbours must be held
+ */
+void dll_syncUnlink(list_t, dllnodeptr);
+/*
+ * Concurrent versions of the insert functions, locking only the nodes around
+ * the new one. `where` selects between inserting before the first node equal
+ * to key (DLL_SYNC_BEFORE), after it (DLL_SYNC_AFTER), or in sorted order,
+ * before the first node bigger than key (DLL_SYNC_SORTED)
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure or on key not found, -1 is returned
+ */
+int dll_syncInsertBack(list_t, void*, void* (*)(void*));
+int dll_syncInsertFront(list_t, void*, void* (*)(void*));
+int dll_syncInsertAt(list_t, void*, void* (*)(void*), void*,
+        int (*)(void*, void*), int);
+/*
+ * Concurrent versions of the delete functions, detaching the node from the
+ * list. The node is returned (NULL if the list is empty or the key is not
+ * found) and its data is left for the caller to free, along with the node
+ */
+dllnodeptr dll_syncDetachFront(list_t);
+dllnodeptr dll_syncDetachBack(list_t);
+dllnodeptr dll_syncDetachKey(list_t, void*, int (*)(void*, void*));
+/*
+ * Tells whether the list is an unrolled one (see dll_init_unrolled), which the
+ * named function does not support, printing an error on its behalf if it is
+ * Return values:
+ *     [*] On unrolled list, 1 is returned
+ *     [*] Otherwise, 0 is returned
+ */
+int dll_unrolledUnsupported(list_t, const char*);
+/*
+ * Allocates an empty node of the unrolled list and links it after the given
+ * node (at the front, for NULL)
+ * Return values:
+ *     [*] On success, the node is returned
+ *     [*] On failure, NULL is returned
+ */
+dllunodeptr dll_unrolledNodeCreate(list_t, dllunodeptr);
+/*
+ * Unlinks the node from the unrolled list and gives it back to the pool.
+ * No iterator may point into it
+ */
+void dll_unrolledNodeRelease(list_t, dllunodeptr);
+/*
+ * Moves the iterators pointing into the unrolled node `from` at offsets from
+ * `first` on into node `to` (which may be `from` itself), adding `delta` to
+ * their offsets
+ */
+void dll_unrolledIteratorsMove(list_t, dllunodeptr, int, dllunodeptr, int);
+/*
+ * Inserts `data` (see dll_nodeSetData) into the unrolled node at the given
+ * offset (the count of the node, to add it after the last element), splitting
+ * the node first if it is full. A NULL node stands for the empty list.
+ * Iterators keep pointing to the same elements
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (the list is left untouched)
+ */
+int dll_unrolledInsert(list_t, dllunodeptr, int, void*, void* (*)(void*));
+/*
+ * Inserts `data` into the sorted unrolled list, after the elements that are
+ * not bigger than it, comparing it with the last element of every node
+ * until the node it belongs to is found
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned
+ */
+int dll_unrolledInsertSorted(list_t, void*, int (*)(void*, void*),
+        void* (*)(void*));
+/*
+ * Takes the element at the given offset of the unrolled node out of the list
+ * and returns it, for the caller to free. Iterators pointing to it move on to
+ * the next element (the previous one, for the tail), or are deleted if the
+ * list is left empty. The node is merged with a neighbour if it is left less
+ * than half full and their elements fit in one node
+ */
+void* dll_unrolledRemove(list_t, dllunodeptr, int);
+/*
+ * Looks for the first element of the unrolled list equal to `key`, storing
+ * its node in the 4th argument
+ * Return values:
+ *     [*] On success, the offset of the element in its node is returned
+ *     [*] On element not found, -1 is returned
+ */
+int dll_unrolledFind(list_t, void*, int (*)(void*, void*), dllunodeptr*);
+/*
+ * Returns the node of the unrolled list holding the element at the given
+ * position (0 for the head), which must be in range, storing its offset in
+ * the 3rd argument. The nodes are walked from the nearer end of the list
+ */
+dllunodeptr dll_unrolledAt(list_t, int, int*);
+/*
+ * Moves the elements of the unrolled `list b` into new nodes of the unrolled
+ * `list a`, whose nodes hold a different number of elements, in the same
+ * order. The new nodes replace the nodes of `list b`, which go away along
+ * with its pool, so that they can be appended to `list a` (see
+ * dll_nodesAdopt)
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned (list b is left intact)
+ */
+int dll_unrolledRepack(list_t, list_t);
+/*
+ * Returns the first element of the sorted unrolled list that is not smaller
+ * than `key`, or NULL if there is none
+ */
+void* dll_unrolledSeek(list_t, void*, int (*)(void*, void*));
+/*
+ * Tells whether the list is a lock-free deque (see dll_init_deque), which the
+ * named function does not support, printing an error on its behalf if it is
+ * Return values:
+ *     [*] On deque, 1 is returned
+ *     [*] Otherwise, 0 is returned
+ */
+int dll_dequeUnsupported(list_t, const char*);
+/*
+ * Turns the (empty, unpooled) list into a lock-free deque
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, or without a double-width compare-and-swap, -1 is
+ *         returned
+ */
+int dll_dequeCreate(list_t);
+/*
+ * Frees the deque state of the list, if there is one, along with the popped
+ * nodes the calling thread can free already. The nodes still in the deque
+ * must be gone (see dll_dequeDrain)
+ */
+void dll_dequeDestroy(list_t);
+/*
+ * Pushes `data` (see dll_nodeSetData) at the given end of the deque
+ * (DLL_DEQUE_FRONT or DLL_DEQUE_BACK), without taking any lock
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned
+ */
+int dll_dequeInsert(list_t, void*, void* (*)(void*), int);
+/*
+ * Pops the element at the given end of the deque, without taking any lock.
+ * The element is stored into `out` unless it is NULL: the element itself (in
+ * a void*) for lists of objects, a copy of its elem_size bytes for inline
+ * lists. The node is retired, to be freed once no thread can reach it
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On empty deque, 1 is returned
+ *     [*] On failure, -1 is returned
+ */
+int dll_dequePop(list_t, int, void*);
+/*
+ * Frees all the nodes of the deque, and their elements unless free_data is
+ * NULL (or the list is inline), leaving it empty. It must not run alongside
+ * other operations on the list
+ */
+void dll_dequeDrain(list_t, void (*)(void*));
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+/*
+ * Reads the anchor of the deque, atomically
+ */
+dllanchor dll_dequeRead(dlldequeptr);
+/*
+ * Replaces the anchor of the deque by `next`, if it still equals `expected`
+ * Return values:
+ *     [*] On success, 1 is returned
+ *     [*] If the anchor has changed, 0 is returned
+ */
+int dll_dequeSwap(dlldequeptr, dllanchor, dllanchor);
+/*
+ * Builds an anchor out of the two ends and the status
+ */
+dllanchor dll_dequeAnchor(dllnodeptr, dllnodeptr, int);
+/*
+ * Returns the given end (DLL_DEQUE_FRONT or DLL_DEQUE_BACK) of the anchor
+ */
+dllnodeptr dll_dequeEnd(dllanchor, int);
+/*
+ * Returns the status of the anchor: DLL_DEQUE_STABLE, or the end with a push
+ * pending plus 1
+ */
+int dll_dequeStatus(dllanchor);
+/*
+ * Returns the link of the node that points towards the given end of the
+ * deque (`previous` for the front, `next` for the back)
+ */
+dllnodeptr* dll_dequeLink(dllnodeptr, int);
+/*
+ * Completes the push pending in `anchor`, linking the old end node to the new
+ * one and marking the anchor stable. Nothing is done if the anchor has
+ * changed meanwhile, as another thread has completed it then
+ */
+void dll_dequeStabilize(list_t, dllhazardsptr, dllanchor);
+#endif
+/*
+ * Returns the hazard pointer record of the calling thread, taking one over
+ * (or allocating it) on its first call
+ * Return values:
+ *     [*] On success, the record is returned
+ *     [*] On failure, NULL is returned
+ */
+dllhazardsptr dll_hazardRecord(void);
+/*
+ * Creates the key of the hazard pointer records (see dll_hazardRecord), once
+ */
+void dll_hazardKeyCreate(void);
+/*
+ * Hands the record of an exiting thread over to the threads to come, after
+ * freeing the nodes it has retired that are no longer published
+ */
+void dll_hazardExit(void*);
+/*
+ * Adds the popped node to the nodes retired by the thread, freeing the ones
+ * that are no longer published when they are too many
+ */
+void dll_hazardRetire(dllhazardsptr, dllnodeptr);
+/*
+ * Frees the nodes retired by the thread that no record publishes
+ */
+void dll_hazardScan(dllhazardsptr);
+/*
+ * Initializes the list for elements of `elem_size` bytes stored inline
+ * (0 for duplicated elements) and with a node pool of `chunk_nodes` nodes
+ * per chunk (-1 for no pool)
+ * Return values:
+ *     [*] On success, 0 is returned
+ *     [*] On failure, -1 is returned
+ */
+int dll_initWith(list_t*, size_t, int);
+/*
+ * Stores `data` in the node, either by copying it into the node payload
+ * (inline lists) or by keeping the object returned by duplicate
+ * With dll_dataAdopt as the duplicate function, the data pointer itself is
+ * stored (adopt inserts)
+ */
+void dll_nodeSetData(list_t, dllnodeptr, void*, void* (*)(void*));
+/*
+ * Returns the object to be stored for `data`: the one returned by duplicate,
+ * or data itself for dll_dataAdopt (see dll_nodeSetData)
+ */
+void* dll_dataDuplicate(list_t, void*, void* (*)(void*));
+/*
+ * Duplicate function of the adopt inserts, which hands the element itself to
+ * the list instead of a copy. The insert functions of the API refuse a NULL
+ * duplicate function, so that taking over an element is always asked for
+ * explicitly
+ */
+void* dll_dataAdopt(void*);
+/*
+ * Tells whether the duplicate function given to the named function is
+ * missing, which only inline lists can do without, printing an error if it is
+ * Return values:
+ *     [*] On missing duplicate function, 1 is returned
+ *     [*] Otherwise, 0 is returned
+ */
+int dll_duplicateMissing(list_t, void* (*)(void*), const char*);
+/*
+ * Frees the element stored in the node with free_data, unless it lives
+ * inside the node (inline lists) or free_data is NULL
+ */
+void dll_nodeFreeData(list_t, dllnodeptr, void (*)(void*));
+/*
+ * Takes an unlinked node out of the indexes of the list, frees its element
+ * (see dll_nodeFreeData) and releases the node. A finger pointing to the node
+ * is moved to one of its former neighbours
+ */
+void dll_nodeDelete(list_t, dllnodeptr, void (*)(void*));
+/*
+ * Returns the node of the mapped list at the given position (0 for the head),
+ * which must be in range, as mapped nodes are laid out in list order
+ */
+dllmapnodeptr dll_mapNodeAt(list_t, int);
+/*
+ * Return the next and the previous node of a node of the mapped list (NULL
+ * for no node)
+ */
+dllmapnodeptr dll_mapNodeNext(list_t, dllmapnodeptr);
+dllmapnodeptr dll_mapNodePrevious(list_t, dllmapnodeptr);
+/*
+ * Tells whether the list is a mapped one (see dll_map_open), which cannot be
+ * changed, printing an error on behalf of the named function if it is
+ * Return values:
+ *     [*] On mapped list, 1 is returned
+ *     [*] Otherwise, 0 is returned
+ */
+int dll_mapReadOnly(list_t, const char*);
+/*
+ * Returns the size of the nodes of mapped lists holding elements of the
+ * given size
+ */
+size_t dll_mapNodeSize(size_t);
+#ifdef DLL_STATS
+/*
+ * Raises the peak size of the list statistics to the current size
+ */
+void dll_statsPeak(list_t);
+/*
+ * Locks the mutex as pthread_mutex_lock does, counting the acquisition and
+ * whether it had to wait for another thread
+ */
+int dll_statsLock(list_t, pthread_mutex_t*);
+/*
+ * Same as pthread_mutex_trylock, counting the acquisition or the contention
+ */
+int dll_statsTrylock(list_t, pthread_mutex_t*);
+#endif
+
+/*
+ * Function responsible for initializing the Doubly Linked List ADT
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init(list_t *listptr_addr)
+{
+    return dll_initWith(listptr_addr, 0, -1);
+}
+
+
+/*
+ * Function responsible for initializing a Doubly Linked List ADT whose nodes
+ * are served by a node pool, in chunks of `chunk_nodes` nodes
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init_pooled(list_t *listptr_addr, int chunk_nodes)
+{
+    if (chunk_nodes <= 0)
+        chunk_nodes = DLL_POOL_CHUNK_NODES;
+    return dll_initWith(listptr_addr, 0, chunk_nodes);
+}
+
+
+/*
+ * Function responsible for initializing a Doubly Linked List ADT that stores
+ * elements of `elem_size` bytes inside its nodes
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init_inline(list_t *listptr_addr, size_t elem_size)
+{
+    if (elem_size == 0) {
+        fprintf(stderr, "dll_init_inline - Error: Element size must not be 0\n");
+        return -1;
+    }
+    return dll_initWith(listptr_addr, elem_size, -1);
+}
+
+
+/*
+ * Function responsible for initializing a Doubly Linked List ADT that stores
+ * elements of `elem_size` bytes inside pooled nodes
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init_inline_pooled(list_t *listptr_addr, size_t elem_size,
+        int chunk_nodes)
+{
+    if (elem_size == 0) {
+        fprintf(stderr, "dll_init_inline_pooled - Error: Element size must not"
+                " be 0\n");
+        return -1;
+    }
+    if (chunk_nodes <= 0)
+        chunk_nodes = DLL_POOL_CHUNK_NODES;
+    return dll_initWith(listptr_addr, elem_size, chunk_nodes);
+}
+
+
+/*
+ * Function responsible for initializing the Doubly Linked List ADT for use by
+ * many threads at once. Inserts, deletes and lookups lock only the nodes they
+ * walk over (hand over hand), so that operations on different parts of the
+ * list run in parallel. Elements are stored inline if `elem_size` is not 0
+ * (see dll_init_inline)
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init_concurrent(list_t *listptr_addr, size_t elem_size)
+{
+    if (dll_initWith(listptr_addr, elem_size, -1) == -1)
+        return -1;
+    if (dll_syncCreate(*listptr_addr) == -1) {
+        dll_destroy(listptr_addr, NULL);
+        return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * Function responsible for initializing a lock-free deque: a list that many
+ * threads push to and pop from at both ends (dll_push_*, dll_pop_*, as well as
+ * the insert, adopt and delete methods of the ends) without taking any lock,
+ * so that a thread that stalls never holds the others up. Elements are
+ * stored inline if `elem_size` is not 0 (see dll_init_inline)
+ * Only the methods of the ends, size, clear and destroy are available for
+ * deques, the last two not alongside other methods
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned (also on platforms without a 16-byte
+ *          compare-and-swap)
+ */
+int dll_init_deque(list_t *listptr_addr, size_t elem_size)
+{
+    if (dll_initWith(listptr_addr, elem_size, -1) == -1)
+        return -1;
+    if (dll_dequeCreate(*listptr_addr) == -1) {
+        dll_destroy(listptr_addr, NULL);
+        return -1;
+    }
+    return 0;
+}
+
+
+/*
+ * Function responsible for initializing an arena list: a pooled list (see
+ * dll_init_pooled) whose elements may also be built in storage carved out of
+ * big blocks by dll_arena_alloc. As long as the elements need no free_data,
+ * dll_clear and dll_destroy release everything in O(number of chunks and
+ * blocks), without visiting the nodes
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init_arena(list_t *listptr_addr, int chunk_nodes)
+{
+    if (chunk_nodes <= 0)
+        chunk_nodes = DLL_POOL_CHUNK_NODES;
+    if (dll_initWith(listptr_addr, 0, chunk_nodes) == -1)
+        return -1;
+    (*listptr_addr)->arena_block = DLL_ARENA_BLOCK;
+    return 0;
+}
+
+
+/*
+ * Function responsible for initializing an unrolled list, whose nodes (taken
+ * from a node pool) hold up to `node_elems` elements each, so that scans walk
+ * one node per run of elements. Elements are duplicated, never stored inline.
+ * Iterators keep pointing to the same elements as nodes are split and merged.
+ * Unrolled lists are appended to unrolled lists only (nodes of another
+ * capacity are repacked). The other bulk methods (insert_many,
+ * insert_sorted_many, remove_if, load, merge_sorted, splice, split_at, sort,
+ * parallel_for_each, reduce) and the indexes and finger are not available
+ * for them
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_init_unrolled(list_t *listptr_addr, int node_elems)
+{
+    if (node_elems <= 0)
+        node_elems = DLL_UNROLLED_NODE_ELEMS;
+    if (node_elems < 2) {
+        fprintf(stderr, "dll_init_unrolled - Error: Nodes must hold at least "
+                "2 elements\n");
+        return -1;
+    }
+    if (dll_initWith(listptr_addr, 0, -1) == -1)
+        return -1;
+    list_t list = *listptr_addr;
+    list->node_size = sizeof(struct DoublyLinkedListUnrolledNode) +
+            node_elems * sizeof(void*);
+    list->pool = dll_poolCreate(DLL_POOL_CHUNK_NODES, list->node_size);
+    list->unrolled = malloc(sizeof(struct DoublyLinkedListUnrolled));
+    if (list->pool == NULL || list->unrolled == NULL) {
+        perror("dll_init_unrolled - Error: ");
+        dll_destroy(listptr_addr, NULL);
+        return -1;
+    }
+    list->unrolled->head = NULL;
+    list->unrolled->tail = NULL;
+    list->unrolled->node_elems = node_elems;
+    return 0;
+}
+
+
+/*
+ * Function that returns `size` bytes of pointer-aligned storage carved out of
+ * the blocks of an arena list, for elements to be inserted into it (by a
+ * duplicate function, or before an adopt insert). The storage is only freed
+ * along with the whole list, by dll_clear and dll_destroy, so such elements
+ * must not be freed with free_data. The list lock is not taken, since
+ * duplicate functions run while the insert functions hold it
+ * Return values:
+ *      [*] On success, the storage is returned
+ *      [*] On failure, NULL is returned
+ */
+void* dll_arena_alloc(list_t list, size_t size)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_arena_alloc - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    if (list->arena_block == 0) {
+        fprintf(stderr, "dll_arena_alloc - Error: Not an arena list\n");
+        return NULL;
+    }
+    size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    dllblockptr block = list->arena;
+    if (block == NULL || block->capacity - block->used < size) {
+        size_t capacity = size > list->arena_block ? size : list->arena_block;
+        dllblockptr grown = malloc(sizeof(struct DoublyLinkedListArenaBlock) +
+                capacity);
+        if (grown == NULL) {
+            perror("dll_arena_alloc - Error: ");
+            return NULL;
+        }
+        grown->capacity = capacity;
+        grown->used = 0;
+        //oversized blocks go behind the block in use, which keeps serving
+        //the usual requests
+        if (block != NULL && capacity > list->arena_block) {
+            grown->next = block->next;
+            block->next = grown;
+        }
+        else {
+            grown->next = block;
+            list->arena = grown;
+        }
+        block = grown;
+    }
+    void* storage = (char*) block->bytes + block->used;
+    block->used += size;
+    return storage;
+}
+
+
+/*
+ * Function returning the size of the list
+ */
+int dll_size(list_t list)
+{
+    int size = 0;
+    //concurrent lists and deques update their size atomically, while the
+    //operations of the former hold the list lock already (dll_isempty is
+    //called from within)
+    if (list->sync != NULL || list->deque != NULL)
+        return __atomic_load_n(&list->size, __ATOMIC_RELAXED);
+    rwl_readLock(list->lock);
+    size = list->size;
+    rwl_readUnlock(list->lock);
+    return size;
+}
+
+/*
+ * Function responsible for checking if the list is empty
+ * Return values:
+ *      [*] on empty list, 1 is returned
+ *      [*] on non empty list, 0 is returned
+ */
+int dll_isempty(list_t list)
+{//is threadsafe because it uses dll_size()
+    if (list == NULL) {
+        fprintf(stderr, "dll_isempty - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_size(list) == 0)
+        return 1;
+    else
+        return 0;
+}
+
+
+/*
+ * Function responsible for filling `out` with the operation statistics of the
+ * list, which are only kept when the library is compiled with -DDLL_STATS
+ * Counters of concurrent lists are read while other threads may be updating
+ * them, so they are not a consistent snapshot of a single moment
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure (or without statistics),  -1 is returned
+ */
+int dll_stats(list_t list, struct dll_stats* out)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_stats - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (out == NULL) {
+        fprintf(stderr, "dll_stats - Error: Output struct is NULL\n");
+        return -1;
+    }
+#ifdef DLL_STATS
+    *out = list->stats;
+    out->size = dll_size(list);
+    return 0;
+#else
+    memset(out, 0, sizeof(struct dll_stats));
+    fprintf(stderr, "dll_stats - Error: Statistics are not compiled in "
+            "(build with -DDLL_STATS)\n");
+    return -1;
+#endif
+}
+
+
+/*
+ * Function responsible for printing the list in this fashion:
+ *          "element -> element -> element" (delimiter "->")
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+void dll_print(const list_t list, void (*print_data)(void* data),
+        int print_inline)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_print - Error: DLList has not been initialized\n");
+        return;
+    }
+    if (dll_dequeUnsupported(list, "dll_print"))
+        return;
+    rwl_readLock(list->lock);
+    if (dll_isempty(list)) {
+        printf("List is empty\n");
+
+    }
+    else {
+        printf("=======Printing list======\n");
+        printf("List size: %d\n", list->size);
+        dllnodeptr current = list->head;
+        dllunodeptr unode = (list->unrolled != NULL) ? list->unrolled->head
+                                                     : NULL;
+        int position, item = 0;
+        for (position = 0; position < list->size; position++) {
+            void* data;
+            if (list->map != NULL)
+                data = dll_mapNodeAt(list, position)->payload;
+            else if (list->unrolled != NULL) {
+                data = unode->items[item];
+                if (++item == unode->count) {
+                    unode = unode->next;
+                    item = 0;
+                }
+            }
+            else {
+                data = current->data;
+                current = current->next;
+            }
+            //no delimiter after the tail element
+            if (print_inline) {
+                (*print_data)(data);
+                if (position < list->size - 1)
+                    printf(" -> ");
+            }
+            else {
+                printf(" -> ");
+                (*print_data)(data);
+                if (position < list->size - 1)
+                    putchar('\n');
+            }
+        }
+
+        printf("\n====Done printing list====\n");
+    }
+    rwl_readUnlock(list->lock);
+    return;
+}
+
+
+/*
+ * Function responsible for inserting an element at the end of the list
+ * The 2nd and 3rd arguments are to be used in conjuction, as the data parameter
+ * acts as a dummy object which is going to be duplicated as a new object of the
+ * data member of the list node struct.
+ * The duplicate function is responsible for allocating a new object and
+ * assigning the values of source to destination.
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_insert_at_back(list_t list, void* data, void* (*duplicate)(void*))
+{
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_at_back - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_at_back"))
+        return -1;
+    // 2. Data must not be NULL
+    if (data == NULL) {
+        fprintf(stderr, "dll_insert_at_back - Error: Data given is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_at_back"))
+        return -1;
+    DLL_STAT(list, inserts_back, 1);
+    if (list->deque != NULL)
+        return dll_dequeInsert(list, data, duplicate, DLL_DEQUE_BACK);
+    if (list->sync != NULL)
+        return dll_syncInsertBack(list, data, duplicate);
+    rwl_writeLock(list->lock);
+    if (list->unrolled != NULL) {
+        dllunodeptr tail = list->unrolled->tail;
+        int retval = dll_unrolledInsert(list, tail,
+                tail != NULL ? tail->count : 0, data, duplicate);
+        if (retval == -1)
+            perror("dll_insert_at_back - Error: ");
+        rwl_writeUnlock(list->lock);
+        return retval;
+    }
+    if (list->size == 0) { // changed from dll_isempty() that to avoid deadlock
+        dllnodeptr elem = dll_nodeAllocate(list);
+        if (elem == NULL) {
+            perror("dll_insert_at_back - Empty list case, error: ");
+            rwl_writeUnlock(list->lock);
+            return -1;
+        }
+        list->head = elem;
+        list->tail = elem;
+        list->size++;
+        DLL_STAT_PEAK(list);
+        elem->next = NULL;
+        elem->previous = NULL;
+        dll_nodeSetData(list, elem, data, duplicate);
+        dll_nodesIndex(list, elem, elem);
+    }
+    else {
+        dllnodeptr elem = dll_nodeAllocate(list);
+        if (elem == NULL) {
+            perror("dll_insert_at_back - Error: ");
+            rwl_writeUnlock(list->lock);
+            return -1;
+        }
+        (list->tail)->next = elem;
+        elem->previous = list->tail;
+        list->tail = elem;
+        list->size++;
+        DLL_STAT_PEAK(list);
+        elem->next = NULL;
+        dll_nodeSetData(list, elem, data, duplicate);
+        dll_nodesIndex(list, elem, elem);
+    }
+    rwl_writeUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Function responsible for inserting an element at the start of the list
+ * The 2nd and 3rd arguments are to be used in conjuction, as the data parameter
+ * acts as a dummy object which is going to be duplicated as a new object of the
+ * data member of the list node struct.
+ * The duplicate function is responsible for allocating a new object and
+ * assigning the values of source to destination.
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_insert_at_front(list_t list, void* data, void* (*duplicate)(void*))
+{
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_at_front - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_at_front"))
+        return -1;
+    // 2. Data must not be NULL
+    if (data == NULL) {
+        fprintf(stderr, "dll_insert_at_front - Error: Data given is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_at_front"))
+        return -1;
+    DLL_STAT(list, inserts_front, 1);
+    if (list->deque != NULL)
+        return dll_dequeInsert(list, data, duplicate, DLL_DEQUE_FRONT);
+    if (list->sync != NULL)
+        return dll_syncInsertFront(list, data, duplicate);
+    rwl_writeLock(list->lock);
+    if (list->unrolled != NULL) {
+        int retval = dll_unrolledInsert(list, list->unrolled->head, 0, data,
+                duplicate);
+        if (retval == -1)
+            perror("dll_insert_at_front - Error: ");
+        rwl_writeUnlock(list->lock);
+        return retval;
+    }
+    if (list->size == 0) {      //changed from dll_isempty() to avoid deadlock
+        dllnodeptr elem = dll_nodeAllocate(list);
+        if (elem == NULL) {
+            perror("dll_insert_at_front - Empty list case, error: ");
+            rwl_writeUnlock(list->lock);
+            return -1;
+        }
+        list->head = elem;
+        list->tail = elem;
+        list->size++;
+        DLL_STAT_PEAK(list);
+        elem->next = NULL;
+        elem->previous = NULL;
+        dll_nodeSetData(list, elem, data, duplicate);
+        dll_nodesIndex(list, elem, elem);
+    }
+    else {
+        dllnodeptr elem = dll_nodeAllocate(list);
+        if (elem == NULL) {
+            perror("dll_insert_at_front - Error: ");
+            rwl_writeUnlock(list->lock);
+            return -1;
+        }
+        (list->head)->previous = elem;
+        elem->next = list->head;
+        list->head = elem;
+        elem->previous = NULL;
+        list->size++;
+        DLL_STAT_PEAK(list);
+        dll_nodeSetData(list, elem, data, duplicate);
+        dll_nodesIndex(list, elem, elem);
+    }
+    rwl_writeUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Function responsible for inserting an element at the end of the list
+ * without duplicating it: the list takes over the object pointed by data,
+ * which is going to be freed by the list (delete/destroy) from now on
+ * Inline lists copy the element into the node instead, the caller keeping
+ * the given object
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_adopt_at_back(list_t list, void* data)
+{
+    return dll_insert_at_back(list, data, &dll_dataAdopt);
+}
+
+
+/*
+ * Function responsible for inserting an element at the start of the list
+ * without duplicating it (see dll_adopt_at_back)
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_adopt_at_front(list_t list, void* data)
+{
+    return dll_insert_at_front(list, data, &dll_dataAdopt);
+}
+
+
+/*
+ * Function responsible for pushing an element at the back of a lock-free
+ * deque (see dll_init_deque), without taking any lock. The deque takes
+ * ownership of the given object, as with dll_adopt_at_back, while inline
+ * deques copy the element into the node
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_push_back(list_t list, void* data)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_push_back - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (list->deque == NULL) {
+        fprintf(stderr, "dll_push_back - Error: Only lock-free deques are "
+                "pushed to (see dll_adopt_at_back)\n");
+        return -1;
+    }
+    if (data == NULL) {
+        fprintf(stderr, "dll_push_back - Error: Data given is NULL\n");
+        return -1;
+    }
+    DLL_STAT(list, inserts_back, 1);
+    return dll_dequeInsert(list, data, &dll_dataAdopt, DLL_DEQUE_BACK);
+}
+
+
+/*
+ * Function responsible for pushing an element at the front of a lock-free
+ * deque (see dll_push_back)
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_push_front(list_t list, void* data)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_push_front - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (list->deque == NULL) {
+        fprintf(stderr, "dll_push_front - Error: Only lock-free deques are "
+                "pushed to (see dll_adopt_at_front)\n");
+        return -1;
+    }
+    if (data == NULL) {
+        fprintf(stderr, "dll_push_front - Error: Data given is NULL\n");
+        return -1;
+    }
+    DLL_STAT(list, inserts_front, 1);
+    return dll_dequeInsert(list, data, &dll_dataAdopt, DLL_DEQUE_FRONT);
+}
+
+
+/*
+ * Function responsible for inserting `count` elements at the end of the list,
+ * in the order they are given. The nodes are allocated in one go (a single
+ * block for pooled lists) and linked under one acquisition of the list lock
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned (the list is left untouched)
+ */
+int dll_insert_many_at_back(list_t list, void** items, int count,
+        void* (*duplicate)(void*))
+{
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_many_at_back - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_many_at_back"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_insert_many_at_back"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_insert_many_at_back"))
+        return -1;
+    // 2. Items must not be NULL
+    if (items == NULL || count < 0) {
+        fprintf(stderr, "dll_insert_many_at_back - Error: Items given are NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_many_at_back"))
+        return -1;
+    if (count == 0)
+        return 0;
+    rwl_writeLock(list->lock);
+    dllnodeptr last = NULL;
+    dllnodeptr first = dll_chainBuild(list, items, count, duplicate, &last);
+    if (first == NULL) {
+        perror("dll_insert_many_at_back - Error: ");
+        rwl_writeUnlock(list->lock);
+        return -1;
+    }
+    DLL_STAT(list, inserts_back, count);
+    if (list->size == 0)
+        list->head = first;
+    else {
+        (list->tail)->next = first;
+        first->previous = list->tail;
+    }
+    list->tail = last;
+    list->size += count;
+    DLL_STAT_PEAK(list);
+    dll_nodesIndex(list, first, last);
+    rwl_writeUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Function responsible for inserting `count` elements at the start of the
+ * list, in the order they are given (items[0] becomes the new head)
+ * Allocation and locking are done as in dll_insert_many_at_back
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned (the list is left untouched)
+ */
+int dll_insert_many_at_front(list_t list, void** items, int count,
+        void* (*duplicate)(void*))
+{
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_many_at_front - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_many_at_front"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_insert_many_at_front"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_insert_many_at_front"))
+        return -1;
+    // 2. Items must not be NULL
+    if (items == NULL || count < 0) {
+        fprintf(stderr, "dll_insert_many_at_front - Error: Items given are NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_many_at_front"))
+        return -1;
+    if (count == 0)
+        return 0;
+    rwl_writeLock(list->lock);
+    dllnodeptr last = NULL;
+    dllnodeptr first = dll_chainBuild(list, items, count, duplicate, &last);
+    if (first == NULL) {
+        perror("dll_insert_many_at_front - Error: ");
+        rwl_writeUnlock(list->lock);
+        return -1;
+    }
+    DLL_STAT(list, inserts_front, count);
+    if (list->size == 0)
+        list->tail = last;
+    else {
+        (list->head)->previous = last;
+        last->next = list->head;
+    }
+    list->head = first;
+    list->size += count;
+    DLL_STAT_PEAK(list);
+    dll_nodesIndex(list, first, last);
+    rwl_writeUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Function responsible for inserting an element into the list while keeping it
+ * sorted by a comparison defined by the user with a function called
+ * issmaller(*). Elements are going to be inserted in ascending order starting
+ * from the head.
+ * The 4th argument (duplication function) is explained at the dll_insert_at_end
+ * function.
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ *
+ * (*): issmaller must be a function that:
+ *      [*] Returns 1, if (1st parameter < 2nd parameter)
+ *      [*] Returns 0, if (1st parameter >= 2nd parameter)
+ */
+int dll_insert_sorted(list_t list, void* data,
+        int (*issmaller)(void*, void*), void* (*duplicate)(void*))
+{
+    /*
+     * Scenarios:
+     *      1. list is empty:
+     *              a. head and tail pointers point to the new node
+     *              b. next and previous pointers point to the node itself
+     *      2. list isn't empty:
+     *              find where in the list the element belongs (cases: )
+     *                  i. element is to be inserted at the end (bigger than
+     */
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_sorted - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_dequeUnsupported(list, "dll_insert_sorted"))
+        return -1;
+    if (dll_mapReadOnly(list, "dll_insert_sorted"))
+        return -1;
+    // 2. Data must not be NULL
+    if (data == NULL) {
+        fprintf(stderr, "dll_insert_sorted - Error: Data given is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_sorted"))
+        return -1;
+    DLL_STAT(list, inserts_sorted, 1);
+    if (list->sync != NULL)
+        return dll_syncInsertAt(list, data, duplicate, data, issmaller,
+                DLL_SYNC_SORTED);
+    if (list->unrolled != NULL) {
+        if (dll_unrolledInsertSorted(list, data, issmaller, duplicate) == -1) {
+            perror("dll_insert_sorted - Error: ");
+            return -1;
+        }
+        return 0;
+    }
+    if (dll_isempty(list))  {
+        dllnodeptr elem = dll_nodeAllocate(list);
+        if (elem == NULL) {
+            perror("dll_insert_sorted: Empty Dllist case, error: ");
+            return -1;
+        }
+        list->head = elem;
+        list->tail = elem;
+        list->size++;
+        DLL_STAT_PEAK(list);
+        elem->next = NULL;
+        elem->previous = NULL;
+        dll_nodeSetData(list, elem, data, duplicate);
+        dll_nodesIndex(list, elem, elem);
+        return 0;
+    }
+    else {
+        //find where the new element is bigger than the tail
+        //so as to avoid the search method
+        DLL_STAT(list, searches, 1);
+        DLL_STAT(list, compares, 1);
+        if ( (*issmaller)((list->tail)->data, data) ) {
+            //case in which the element is to be added into the end of the list
+            dllnodeptr elem = dll_nodeAllocate(list);
+            if (elem == NULL) {
+                perror("dll_insert_sorted: Tail insertion case, error: ");
+                return -1;
+            }
+            (list->tail)->next = elem;
+            elem->previous = list->tail;
+            elem->next = NULL;
+            list->tail = elem;
+            list->size++;
+            DLL_STAT_PEAK(list);
+            dll_nodeSetData(list, elem, data, duplicate);
+            dll_nodesIndex(list, elem, elem);
+            return 0;
+        }
+        //search method, skipping ahead through the skip index if there is one
+        dllnodeptr current = NULL;
+        if (list->index != NULL)
+            current = dll_indexSeek(list, data, issmaller, 1);
+        if (current == NULL)
+            current = list->head;
+        do {
+            DLL_STAT(list, search_visits, 1);
+            DLL_STAT(list, compares, 1);
+            if ( (*issmaller)(data, current->data) )
+                break;
+            else {
+                if (current == list->tail)
+                    break;
+                else
+                    current = current->next;
+            }
+        }while(1);
+        //here we must identify which break occurred
+        if (current == list->head) {
+            //case in which the element is to be added into the start of the list
+            dllnodeptr elem = dll_nodeAllocate(list);
+            if (elem == NULL) {
+                perror("dll_insert_sorted: Tail insertion case, error: ");
+                return -1;
+            }
+            elem->next = list->head;
+            elem->previous = NULL;
+            (elem->next)->previous = elem;
+            list->head = elem;
+            list->size++;
+            DLL_STAT_PEAK(list);
+            dll_nodeSetData(list, elem, data, duplicate);
+            dll_nodesIndex(list, elem, elem);
+            return 0;
+        }
+        else {
+            //add the element before the current node
+            dllnodeptr elem = dll_nodeAllocate(list);
+            if (elem == NULL) {
+                perror("dll_insert_sorted - Error: ");
+                return -1;
+            }
+            (current->previous)->next = elem;
+            elem->previous = current->previous;
+            current->previous = elem;
+            elem->next = current;
+            list->size++;
+            DLL_STAT_PEAK(list);
+            dll_nodeSetData(list, elem, data, duplicate);
+            dll_nodesIndex(list, elem, elem);
+            return 0;
+        }
+    }
+}
+
+
+/*
+ * Function responsible for inserting an element into the sorted list without
+ * duplicating it (see dll_adopt_at_back and dll_insert_sorted)
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned
+ */
+int dll_adopt_sorted(list_t list, void* data, int (*issmaller)(void*, void*))
+{
+    return dll_insert_sorted(list, data, issmaller, &dll_dataAdopt);
+}
+
+
+/*
+ * Function responsible for inserting `count` elements into the sorted list in
+ * one go. The batch is sorted on its own and then merged into the list in a
+ * single forward pass, costing O(n + k log k) instead of the O(n * k) of
+ * calling dll_insert_sorted for every element. The insertion is stable: among
+ * equal elements, the ones already in the list come first, followed by the new
+ * ones in the order they were given
+ * The 5th argument (duplication function) is explained at the
+ * dll_insert_at_end function.
+ * Return values:
+ *      [*] On success,  0 is returned
+ *      [*] On failure,  -1 is returned (the list is left untouched)
+ */
+int dll_insert_sorted_many(list_t list, void** items, int count,
+        int (*issmaller)(void*, void*), void* (*duplicate)(void*))
+{
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_sorted_many - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_sorted_many"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_insert_sorted_many"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_insert_sorted_many"))
+        return -1;
+    // 2. Items must not be NULL
+    if (items == NULL || count < 0) {
+        fprintf(stderr, "dll_insert_sorted_many - Error: Items given are NULL\n");
+        return -1;
+    }
+    // 3. Comparison function must not be NULL
+    if (issmaller == NULL) {
+        fprintf(stderr, "dll_insert_sorted_many - Error: Comparison function is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_sorted_many"))
+        return -1;
+    if (count == 0)
+        return 0;
+    rwl_writeLock(list->lock);
+    dllnodeptr last = NULL;
+    dllnodeptr first = dll_chainBuild(list, items, count, duplicate, &last);
+    if (first == NULL) {
+        perror("dll_insert_sorted_many - Error: ");
+        rwl_writeUnlock(list->lock);
+        return -1;
+    }
+    DLL_STAT(list, inserts_sorted, count);
+    //hash slots do not depend on the order of the nodes
+    if (list->hash != NULL) {
+        dllnodeptr current;
+        for (current = first; current != NULL; current = current->next)
+            if (dll_hashInsert(list, current) == -1)
+                break;
+    }
+    first = dll_chainSort(first, issmaller);
+    //elements already in the list come first among equals
+    dll_chainRelink(list, dll_chainMerge(list->head, first, issmaller));
+    list->size += count;
+    DLL_STAT_PEAK(list);
+    //towers follow the order of the nodes, so the skip index is rebuilt
+    if (list->index != NULL) {
+        dll_indexDestroy(list);
+        dll_indexEnable(list);
+    }
+    rwl_writeUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Inserts the element `data` before the `key` element provided. If the key is
+ * not found -1 is returned.
+ * Return values:
+ *      [*]: On success, 0 is returned
+ *      [*]: On error or `on key not found`, -1 is returned
+ */
+int dll_insert_before(list_t list, void* data, void* (*duplicate)(void*),
+        void* key, int (*is_equal)(void*, void*))
+{
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_before - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_before"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_insert_before"))
+        return -1;
+    // 2. Data must not be NULL
+    if (data == NULL) {
+        fprintf(stderr, "dll_insert_before - Error: Data given is NULL\n");
+        return -1;
+    }
+    // 3. Key must not be NULL
+    if (key == NULL) {
+        fprintf(stderr, "dll_insert_before - Error: Key given is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_before"))
+        return -1;
+    DLL_STAT(list, inserts_keyed, 1);
+    if (list->sync != NULL)
+        return dll_syncInsertAt(list, data, duplicate, key, is_equal,
+                DLL_SYNC_BEFORE);
+    if (list->unrolled != NULL) {
+        dllunodeptr node;
+        int offset = dll_unrolledFind(list, key, is_equal, &node);
+        if (offset == -1)
+            return -1;
+        if (dll_unrolledInsert(list, node, offset, data, duplicate) == -1) {
+            perror("dll_insert_before - Error: ");
+            return -1;
+        }
+        return 0;
+    }
+    //find the element (if it exits)
+    dllnodeptr current = dll_nodeFind(list, key, is_equal);
+    if (current == NULL)
+        return -1;
+    //found correct place
+    //add the element before the current node
+    dllnodeptr elem = dll_nodeAllocate(list);
+    if (elem == NULL) {
+        perror("dll_insert_sorted - Error: ");
+        return -1;
+    }
+    elem->previous = current->previous;
+    elem->next = current;
+    if (current != list->head)
+        (current->previous)->next = elem;
+    else {
+        list->head = elem;
         elem->previous = NULL;
-        list->size++;
-        elem->data = (*duplicate)(data);
     }
-    rwl_writeUnlock(list->lock);
+    current->previous = elem;
+    dll_nodeSetData(list, elem, data, duplicate);
+    dll_nodesIndex(list, elem, elem);
+    list->size++;
+    DLL_STAT_PEAK(list);
+    return 0;
+}
+
+
+/*
+ * Inserts the element `data` after the `key` element provided. If the key is
+ * not found -1 is returned.
+ * Return values:
+ *      [*]: On success, 0 is returned
+ *      [*]: On error or `on key not found`, -1 is returned
+ */
+int dll_insert_after(list_t list, void* data, void* (*duplicate)(void*),
+        void* key, int (*is_equal)(void*, void*)) {
+    // Safety checks firstly
+    // 1. Dllist must be initialized
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_before - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_after"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_insert_after"))
+        return -1;
+    // 2. Data must not be NULL
+    if (data == NULL) {
+        fprintf(stderr, "dll_insert_before - Error: Data given is NULL\n");
+        return -1;
+    }
+    // 3. Key must not be NULL
+    if (key == NULL) {
+        fprintf(stderr, "dll_insert_before - Error: Key given is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_after"))
+        return -1;
+    DLL_STAT(list, inserts_keyed, 1);
+    if (list->sync != NULL)
+        return dll_syncInsertAt(list, data, duplicate, key, is_equal,
+                DLL_SYNC_AFTER);
+    if (list->unrolled != NULL) {
+        dllunodeptr node;
+        int offset = dll_unrolledFind(list, key, is_equal, &node);
+        if (offset == -1)
+            return -1;
+        if (dll_unrolledInsert(list, node, offset + 1, data, duplicate) == -1) {
+            perror("dll_insert_after - Error: ");
+            return -1;
+        }
+        return 0;
+    }
+    //find the element (if it exits)
+    dllnodeptr current = dll_nodeFind(list, key, is_equal);
+    if (current == NULL)
+        return -1;
+    //found correct place
+    //add the element after the current node
+    dllnodeptr elem = dll_nodeAllocate(list);
+    if (elem == NULL) {
+        perror("dll_insert_sorted - Error: ");
+        return -1;
+    }
+    elem->next = current->next;
+    elem->previous = current;
+    if (current != list->tail)
+        (current->next)->previous = elem;
+    else {
+        list->tail = elem;
+        elem->next = NULL;
+    }
+    current->next = elem;
+    dll_nodeSetData(list, elem, data, duplicate);
+    dll_nodesIndex(list, elem, elem);
+    list->size++;
+    DLL_STAT_PEAK(list);
+    return 0;
+}
+
+
+/*
+ * Inserts the element `data` at the given position of the list, so that it
+ * becomes the element at that position (0 for the head, the size of the list
+ * for the back). The place is found as in dll_get_at
+ * Return values:
+ *      [*]: On success, 0 is returned
+ *      [*]: On error or on position out of range, -1 is returned
+ */
+int dll_insert_at(list_t list, void* data, void* (*duplicate)(void*),
+        int position)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_insert_at - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_insert_at"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_insert_at"))
+        return -1;
+    if (data == NULL) {
+        fprintf(stderr, "dll_insert_at - Error: Data given is NULL\n");
+        return -1;
+    }
+    if (dll_duplicateMissing(list, duplicate, "dll_insert_at"))
+        return -1;
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_insert_at - Error: Not available for concurrent "
+                "lists\n");
+        return -1;
+    }
+    if (position < 0 || position > list->size) {
+        fprintf(stderr, "dll_insert_at - Error: Position %d is out of range\n",
+                position);
+        return -1;
+    }
+    if (position == 0)
+        return dll_insert_at_front(list, data, duplicate);
+    if (position == list->size)
+        return dll_insert_at_back(list, data, duplicate);
+    DLL_STAT(list, inserts_at, 1);
+    if (list->unrolled != NULL) {
+        int offset;
+        dllunodeptr node = dll_unrolledAt(list, position, &offset);
+        if (dll_unrolledInsert(list, node, offset, data, duplicate) == -1) {
+            perror("dll_insert_at - Error: ");
+            return -1;
+        }
+        return 0;
+    }
+    //add the element before the node currently at that position
+    dllnodeptr current = dll_nodeAt(list, position);
+    dllnodeptr elem = dll_nodeAllocate(list);
+    if (elem == NULL) {
+        perror("dll_insert_at - Error: ");
+        return -1;
+    }
+    elem->previous = current->previous;
+    elem->next = current;
+    (current->previous)->next = elem;
+    current->previous = elem;
+    dll_nodeSetData(list, elem, data, duplicate);
+    dll_nodesIndex(list, elem, elem);
+    list->size++;
+    DLL_STAT_PEAK(list);
+    return 0;
+}
+
+
+/*
+ * Function that enables accessing data at the list, identified by the 2nd
+ * argument, with an is_equal type function as 3rd argument
+ * Return values:
+ *      [*] On success, the object is returned
+ *      [*] On element not found or on error, NULL is returned
+ */
+void* dll_edit_data(list_t list, void* data, int (*is_equal)(void*, void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_edit_data - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    //the elements of mapped lists lie in read-only pages
+    if (dll_mapReadOnly(list, "dll_edit_data"))
+        return NULL;
+    if (dll_dequeUnsupported(list, "dll_edit_data"))
+        return NULL;
+    if(dll_isempty(list)) {
+        return NULL;
+    }
+    else if (list->sync != NULL) {
+        //the element is only locked while looking for it
+        rwl_readLock(list->lock);
+        dllnodeptr previous, current = dll_syncSeek(list, data, is_equal,
+                &previous);
+        void* found = NULL;
+        if (current != NULL) {
+            found = current->data;
+            pthread_mutex_unlock(dll_syncMutex(list, current, NULL));
+        }
+        pthread_mutex_unlock(dll_syncMutex(list, previous, &list->sync->head));
+        rwl_readUnlock(list->lock);
+        return found;
+    }
+    else if (list->unrolled != NULL) {
+        dllunodeptr node;
+        int offset = dll_unrolledFind(list, data, is_equal, &node);
+        return (offset == -1) ? NULL : node->items[offset];
+    }
+    else {
+        //find the element (if it exits)
+        dllnodeptr current = dll_nodeFind(list, data, is_equal);
+        if (current == NULL)
+            return NULL;
+        return current->data;
+    }
+}
+
+
+/*
+ * Function that returns a copy of the data located at the front (Head) of
+ * the list, if getCopy option is true, or the actual data if the option is
+ * set to 0 (false)
+ */
+const void* dll_get_front(list_t list, void* (*duplicate)(void*),
+        int getCopy) {
+    // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_get_front - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    //a pop may free the node while it is read
+    if (dll_dequeUnsupported(list, "dll_get_front"))
+        return NULL;
+    if(dll_isempty(list)) {
+        fprintf(stderr, "dll_get_front - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return NULL;
+    }
+    if (list->sync != NULL) {
+        const void* data = NULL;
+        rwl_readLock(list->lock);
+        DLL_LOCK(list, &list->sync->head);
+        dllnodeptr first = list->head;
+        if (first != NULL) {
+            DLL_LOCK(list, dll_syncMutex(list, first, NULL));
+            DLL_STAT(list, duplicates, getCopy != 0);
+            data = getCopy ? (*duplicate)(first->data) : first->data;
+            pthread_mutex_unlock(dll_syncMutex(list, first, NULL));
+        }
+        pthread_mutex_unlock(&list->sync->head);
+        rwl_readUnlock(list->lock);
+        return data;
+    }
+    void* data;
+    if (list->map != NULL)
+        data = dll_mapNodeAt(list, 0)->payload;
+    else if (list->unrolled != NULL)
+        data = list->unrolled->head->items[0];
+    else
+        data = list->head->data;
+    DLL_STAT(list, duplicates, getCopy != 0);
+    if (getCopy)
+        return (*duplicate)(data);
+    else
+        return data;
+}
+
+
+/*
+ * Function that returns a copy of the data located at the back (Tail) of
+ * the list, if getCopy option is true, or the actual data if the option is
+ * set to 0 (false)
+ */
+const void* dll_get_back(list_t list, void* (*duplicate)(void*),
+        int getCopy) {
+    // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_get_back - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    //a pop may free the node while it is read
+    if (dll_dequeUnsupported(list, "dll_get_back"))
+        return NULL;
+    if(dll_isempty(list)) {
+        fprintf(stderr, "dll_get_back - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return NULL;
+    }
+    if (list->sync != NULL) {
+        const void* data = NULL;
+        rwl_readLock(list->lock);
+        dllnodeptr last = dll_syncLockBack(list);
+        if (last != NULL) {
+            DLL_STAT(list, duplicates, getCopy != 0);
+            data = getCopy ? (*duplicate)(last->data) : last->data;
+            pthread_mutex_unlock(dll_syncMutex(list, last, NULL));
+        }
+        pthread_mutex_unlock(&list->sync->tail);
+        rwl_readUnlock(list->lock);
+        return data;
+    }
+    void* data;
+    if (list->map != NULL)
+        data = dll_mapNodeAt(list, list->size - 1)->payload;
+    else if (list->unrolled != NULL)
+        data = list->unrolled->tail->items[list->unrolled->tail->count - 1];
+    else
+        data = list->tail->data;
+    DLL_STAT(list, duplicates, getCopy != 0);
+    if (getCopy)
+        return (*duplicate)(data);
+    else
+        return data;
+}
+
+
+/*
+ * Function that is responsible for copying src list to dest list
+ * Dest list must be initialized and empty
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ *      [*] On destination list not empty, 2 is returned
+ *      [*] On empty source list, 1 is returned
+ */
+int dll_copy(list_t src, list_t dest, void* (*duplicate)(void*),
+        void (*free_data)(void*))
+{
+    // check if list is null
+    if (src == NULL) {
+        fprintf(stderr, "dll_copy - Error: Source list has not been initialized\n");
+        return -1;
+    }
+    // check if list is null
+    if (dest == NULL) {
+        fprintf(stderr, "dll_copy - Error: Destination list has not been "
+                "initialized\n");
+        return -1;
+    }
+    if (dll_dequeUnsupported(src, "dll_copy") ||
+            dll_dequeUnsupported(dest, "dll_copy"))
+        return -1;
+    if(!dll_isempty(dest)) {
+        fprintf(stderr, "dll_copy - Error: Destination list is not empty\n");
+        return 2;
+    }
+    if (dll_duplicateMissing(dest, duplicate, "dll_copy"))
+        return -1;
+    if(dll_isempty(src)) {
+        fprintf(stderr, "dll_copy - Notify: Source list is empty\n");
+        // nothing to do here
+        return 1;
+    }
+    // iterate through source list
+    IteratorID srcIter = dll_iteratorRequest(src);
+    if (srcIter == -1) {
+        fprintf(stderr, "dll_copy - Error: Requesting iterator for the source "
+        "list failed\n");
+        return -1;
+    }
+    while (1) {
+        // insert data pointed
+        void* data = dll_iteratorGetObj(src, srcIter);
+        if (data == NULL) {
+            fprintf(stderr, "dll_copy - Error: Cannot access data from source"
+                    " list\nDestroying destination list completely\n");
+            dll_iteratorDelete(src, srcIter);
+            dll_destroy(&dest, free_data);
+            return -1;
+        }
+        if (dll_insert_at_back(dest, data, duplicate) == -1) {
+            fprintf(stderr, "dll_copy - Error: Cannot insert data to "
+            " destination list\n"
+                    "Destroying destination list completely\n");
+            dll_iteratorDelete(src, srcIter);
+            dll_destroy(&dest, free_data);
+            return -1;
+        }
+        int retval = dll_iteratorNext(src, srcIter);
+        if (retval == 2)
+            // reached end of the source list, end loop
+            break;
+        else if (retval == -1) {
+            fprintf(stderr, "dll_copy - Error: Cannot iterate through source "
+                    "list\nDestroying destination list completely\n");
+            dll_iteratorDelete(src, srcIter);
+            dll_destroy(&dest, free_data);
+            return -1;
+        }
+    }
+    dll_iteratorDelete(src, srcIter);
+    return 0;
+}
+
+
+/*
+ * Function responsible for writing a snapshot of the list to the file
+ * descriptor fd (from its current offset), to be read back by dll_load
+ * The snapshot holds a header (magic number, element size and number of
+ * elements) followed by the elements: the payloads of inline lists as they
+ * are, and otherwise records of the bytes written by serialize, prefixed by
+ * their length. Everything is written in the byte order of the host, through
+ * a large buffer
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_save(list_t list, int fd, int (*serialize)(void*, void*, size_t))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_save - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_dequeUnsupported(list, "dll_save"))
+        return -1;
+    if (list->elem_size == 0 && serialize == NULL) {
+        fprintf(stderr, "dll_save - Error: Serialize function is NULL\n");
+        return -1;
+    }
+    dllio io = { fd, malloc(DLL_IO_BUFFER), DLL_IO_BUFFER, 0, 0 };
+    if (io.buffer == NULL) {
+        perror("dll_save - Error: ");
+        return -1;
+    }
+    if (list->sync != NULL)
+        rwl_writeLock(list->lock);
+    else
+        rwl_readLock(list->lock);
+    uint32_t magic = DLL_SNAPSHOT_MAGIC, elem_size = list->elem_size;
+    uint64_t count = list->size;
+    char* room = io.buffer;
+    memcpy(room, &magic, sizeof(magic));
+    memcpy(room + sizeof(magic), &elem_size, sizeof(elem_size));
+    memcpy(room + sizeof(magic) + sizeof(elem_size), &count, sizeof(count));
+    io.end = sizeof(magic) + sizeof(elem_size) + sizeof(count);
+    int retval = 0;
+    dllnodeptr current = list->head;
+    dllunodeptr unode = (list->unrolled != NULL) ? list->unrolled->head
+                                                 : NULL;
+    int position, item = 0;
+    for (position = 0; position < list->size; position++) {
+        void* data;
+        if (list->map != NULL)
+            data = dll_mapNodeAt(list, position)->payload;
+        else if (list->unrolled != NULL) {
+            data = unode->items[item];
+            if (++item == unode->count) {
+                unode = unode->next;
+                item = 0;
+            }
+        }
+        else {
+            data = current->data;
+            current = current->next;
+        }
+        if (list->elem_size > 0) {
+            room = dll_ioReserve(&io, list->elem_size);
+            if (room == NULL) {
+                retval = -1;
+                break;
+            }
+            memcpy(room, data, list->elem_size);
+            io.end += list->elem_size;
+            continue;
+        }
+        //records are serialized straight into the buffer, and once more
+        //after making room for them, if they do not fit
+        uint32_t length;
+        room = dll_ioReserve(&io, sizeof(length));
+        if (room == NULL) {
+            retval = -1;
+            break;
+        }
+        size_t space = io.capacity - io.end - sizeof(length);
+        int needed = (*serialize)(data, room + sizeof(length), space);
+        if (needed > 0 && (size_t) needed > space) {
+            space = needed;
+            room = dll_ioReserve(&io, sizeof(length) + space);
+            if (room == NULL) {
+                retval = -1;
+                break;
+            }
+            needed = (*serialize)(data, room + sizeof(length), space);
+        }
+        if (needed < 0 || (size_t) needed > space) {
+            fprintf(stderr, "dll_save - Error: Cannot serialize an element\n");
+            retval = -2;
+            break;
+        }
+        length = needed;
+        memcpy(room, &length, sizeof(length));
+        io.end += sizeof(length) + length;
+    }
+    if (retval == 0)
+        retval = dll_ioFlush(&io);
+    if (retval == -1)
+        perror("dll_save - Error: ");
+    if (list->sync != NULL)
+        rwl_writeUnlock(list->lock);
+    else
+        rwl_readUnlock(list->lock);
+    free(io.buffer);
+    return retval == 0 ? 0 : -1;
+}
+
+
+/*
+ * Function responsible for reading a snapshot written by dll_save from the
+ * file descriptor fd, and inserting its elements at the back of the list
+ * (which must store its elements the same way as the saved one), in batches
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned (the elements read up to then are left
+ *          in the list)
+ */
+int dll_load(list_t list, int fd, void* (*deserialize)(const void*, size_t),
+        void (*free_data)(void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_load - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_load"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_load"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_load"))
+        return -1;
+    if (list->elem_size == 0 && deserialize == NULL) {
+        fprintf(stderr, "dll_load - Error: Deserialize function is NULL\n");
+        return -1;
+    }
+    dllio io = { fd, malloc(DLL_IO_BUFFER), DLL_IO_BUFFER, 0, 0 };
+    //inline elements are copied out of the buffer, which moves on refills
+    char* stage = NULL;
+    if (list->elem_size > 0)
+        stage = malloc(DLL_LOAD_BATCH * list->elem_size);
+    if (io.buffer == NULL || (list->elem_size > 0 && stage == NULL)) {
+        perror("dll_load - Error: ");
+        free(io.buffer);
+        free(stage);
+        return -1;
+    }
+    uint32_t magic = 0, elem_size = 0;
+    uint64_t count = 0;
+    char* record = dll_ioTake(&io,
+            sizeof(magic) + sizeof(elem_size) + sizeof(count));
+    if (record != NULL) {
+        memcpy(&magic, record, sizeof(magic));
+        memcpy(&elem_size, record + sizeof(magic), sizeof(elem_size));
+        memcpy(&count, record + sizeof(magic) + sizeof(elem_size),
+                sizeof(count));
+    }
+    int retval = 0;
+    if (magic != DLL_SNAPSHOT_MAGIC) {
+        fprintf(stderr, "dll_load - Error: Not a snapshot of a list (or one "
+                "saved with another byte order)\n");
+        retval = -1;
+    }
+    else if (elem_size != list->elem_size) {
+        fprintf(stderr, "dll_load - Error: Snapshot holds elements of "
+                "different kind\n");
+        retval = -1;
+    }
+    else if (count > (uint64_t) (INT_MAX - dll_size(list))) {
+        fprintf(stderr, "dll_load - Error: Snapshot holds too many elements\n");
+        retval = -1;
+    }
+    void* items[DLL_LOAD_BATCH];
+    int batch = 0;
+    uint64_t loaded;
+    for (loaded = 0; retval == 0 && loaded < count; loaded++) {
+        if (elem_size > 0) {
+            record = dll_ioTake(&io, elem_size);
+            if (record == NULL) {
+                retval = -1;
+                break;
+            }
+            items[batch] = stage + batch * elem_size;
+            memcpy(items[batch++], record, elem_size);
+        }
+        else {
+            uint32_t length;
+            record = dll_ioTake(&io, sizeof(length));
+            if (record != NULL) {
+                memcpy(&length, record, sizeof(length));
+                record = dll_ioTake(&io, length);
+            }
+            if (record == NULL) {
+                retval = -1;
+                break;
+            }
+            items[batch] = (*deserialize)(record, length);
+            if (items[batch] == NULL) {
+                fprintf(stderr, "dll_load - Error: Cannot deserialize an "
+                        "element\n");
+                retval = -1;
+                break;
+            }
+            batch++;
+        }
+        if (batch == DLL_LOAD_BATCH || loaded + 1 == count) {
+            //inserted as they are, deserialized elements are adopted
+            if (dll_insert_many_at_back(list, items, batch,
+                    &dll_dataAdopt) == -1) {
+                retval = -1;
+                break;
+            }
+            batch = 0;
+        }
+    }
+    if (record == NULL && retval == -1 && magic == DLL_SNAPSHOT_MAGIC)
+        fprintf(stderr, "dll_load - Error: Snapshot is truncated or cannot "
+                "be read\n");
+    if (elem_size == 0 && free_data != NULL)
+        while (batch > 0)
+            (*free_data)(items[--batch]);
+    //give back what was read past the snapshot, where the file allows it
+    if (io.end > io.start)
+        lseek(fd, -(off_t) (io.end - io.start), SEEK_CUR);
+    free(io.buffer);
+    free(stage);
+    return retval;
+}
+
+
+/*
+ * Function responsible for writing the list to the file at `path` in the
+ * layout of mapped lists (see dll_map_open): a header followed by the nodes,
+ * in list order, which link to each other with their offsets in the file and
+ * hold their element inline. The elements of inline lists keep their size,
+ * while the ones of other lists are copied byte by byte as objects of
+ * `elem_size` bytes (so they must not point to anything)
+ * The file is written next to `path` and then renamed over it, so that
+ * processes which have mapped the previous version keep reading it unharmed
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_map_save(list_t list, const char* path, size_t elem_size)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_map_save - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_dequeUnsupported(list, "dll_map_save"))
+        return -1;
+    if (path == NULL) {
+        fprintf(stderr, "dll_map_save - Error: Path given is NULL\n");
+        return -1;
+    }
+    if (list->elem_size > 0)
+        elem_size = list->elem_size;
+    if (elem_size == 0 || elem_size > UINT32_MAX) {
+        fprintf(stderr, "dll_map_save - Error: Element size must not be 0 "
+                "(or too big)\n");
+        return -1;
+    }
+    size_t node_size = dll_mapNodeSize(elem_size);
+    char* temporary = malloc(strlen(path) + sizeof(".tmp"));
+    if (temporary == NULL) {
+        perror("dll_map_save - Error: ");
+        return -1;
+    }
+    strcpy(temporary, path);
+    strcat(temporary, ".tmp");
+    dllio io = { open(temporary, O_WRONLY | O_CREAT | O_TRUNC, 0644),
+            malloc(DLL_IO_BUFFER), DLL_IO_BUFFER, 0, 0 };
+    if (io.fd == -1 || io.buffer == NULL) {
+        perror("dll_map_save - Error: ");
+        if (io.fd != -1) {
+            close(io.fd);
+            unlink(temporary);
+        }
+        free(io.buffer);
+        free(temporary);
+        return -1;
+    }
+    if (list->sync != NULL)
+        rwl_writeLock(list->lock);
+    else
+        rwl_readLock(list->lock);
+    //nodes follow the header in list order, so their offsets are known
+    dllmapheader header = { DLL_MAP_MAGIC, elem_size, list->size, node_size,
+            0, 0 };
+    if (list->size > 0) {
+        header.head = sizeof(dllmapheader);
+        header.tail = sizeof(dllmapheader) +
+                (uint64_t) (list->size - 1) * node_size;
+    }
+    memcpy(io.buffer, &header, sizeof(header));
+    io.end = sizeof(header);
+    int retval = 0;
+    uint64_t offset = sizeof(dllmapheader);
+    dllnodeptr current = list->head;
+    dllunodeptr unode = (list->unrolled != NULL) ? list->unrolled->head
+                                                 : NULL;
+    int position, item = 0;
+    for (position = 0; position < list->size; position++) {
+        void* data;
+        if (list->map != NULL)
+            data = dll_mapNodeAt(list, position)->payload;
+        else if (list->unrolled != NULL) {
+            data = unode->items[item];
+            if (++item == unode->count) {
+                unode = unode->next;
+                item = 0;
+            }
+        }
+        else {
+            data = current->data;
+            current = current->next;
+        }
+        dllmapnodeptr node = (dllmapnodeptr) dll_ioReserve(&io, node_size);
+        if (node == NULL) {
+            retval = -1;
+            break;
+        }
+        node->previous = (position == 0) ? 0 : offset - node_size;
+        node->next = (position == list->size - 1) ? 0 : offset + node_size;
+        memcpy(node->payload, data, elem_size);
+        //padding is zeroed, so that no stray bytes end up in the file
+        memset((char*) node->payload + elem_size, 0,
+                node_size - sizeof(struct DoublyLinkedListMapNode) - elem_size);
+        io.end += node_size;
+        offset += node_size;
+    }
+    if (retval == 0)
+        retval = dll_ioFlush(&io);
+    if (list->sync != NULL)
+        rwl_writeUnlock(list->lock);
+    else
+        rwl_readUnlock(list->lock);
+    if (close(io.fd) == -1)
+        retval = -1;
+    if (retval == 0 && rename(temporary, path) == -1)
+        retval = -1;
+    if (retval == -1) {
+        perror("dll_map_save - Error: ");
+        unlink(temporary);
+    }
+    free(io.buffer);
+    free(temporary);
+    return retval;
+}
+
+
+/*
+ * Function responsible for opening the file written by dll_map_save at `path`
+ * as a read-only list, in O(1): the file is mapped (shared, so that all the
+ * processes that open it read the same pages) and its nodes are used where
+ * they lie, without reading or converting anything
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_map_open(list_t *listptr_addr, const char* path)
+{
+    if (listptr_addr == NULL || path == NULL) {
+        fprintf(stderr, "dll_map_open - Error: Pointer to the list or path "
+                "given is NULL\n");
+        return -1;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        perror("dll_map_open - Error: ");
+        return -1;
+    }
+    struct stat status;
+    if (fstat(fd, &status) == -1) {
+        perror("dll_map_open - Error: ");
+        close(fd);
+        return -1;
+    }
+    dllmapheader header;
+    if ((size_t) status.st_size < sizeof(header)) {
+        fprintf(stderr, "dll_map_open - Error: Not the file of a mapped list\n");
+        close(fd);
+        return -1;
+    }
+    char* map = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("dll_map_open - Error: ");
+        return -1;
+    }
+    //only the header is checked, the nodes must lie in list order after it
+    memcpy(&header, map, sizeof(header));
+    uint64_t first = header.count > 0 ? sizeof(header) : 0;
+    uint64_t last = header.count > 0 ?
+            sizeof(header) + (header.count - 1) * header.node_size : 0;
+    if (header.magic != DLL_MAP_MAGIC || header.elem_size == 0 ||
+            header.node_size != dll_mapNodeSize(header.elem_size) ||
+            header.count > INT_MAX ||
+            header.count * header.node_size !=
+                    status.st_size - sizeof(header) ||
+            header.head != first || header.tail != last) {
+        fprintf(stderr, "dll_map_open - Error: Not the file of a mapped list "
+                "(or one written with another byte order)\n");
+        munmap(map, status.st_size);
+        return -1;
+    }
+    if (dll_initWith(listptr_addr, header.elem_size, -1) == -1) {
+        munmap(map, status.st_size);
+        return -1;
+    }
+    list_t list = *listptr_addr;
+    list->map = map;
+    list->map_length = status.st_size;
+    list->node_size = header.node_size;
+    list->size = header.count;
+    DLL_STAT_PEAK(list);
+    return 0;
+}
+
+
+/*
+ * Function responsible for appending `list b` to `list a`
+ * Upon return, the second list is going to be freed
+ * and nullified, so that it cannot longer be used
+ * On failure (a list appended to itself, or lists of different kinds whose
+ * nodes cannot be moved), both lists are left untouched and `list b` is not
+ * nullified
+ */
+void dll_append(list_t alist, list_t* listptrb)
+{
+    if (alist == NULL || listptrb == NULL || *listptrb == NULL) {
+        fprintf(stderr, "dll_append - Error: DLList has not been initialized\n");
+        return;
+    }
+    if (dll_mapReadOnly(alist, "dll_append") ||
+            dll_mapReadOnly(*listptrb, "dll_append"))
+        return;
+    if (dll_dequeUnsupported(alist, "dll_append") ||
+            dll_dequeUnsupported(*listptrb, "dll_append"))
+        return;
+    if (alist == *listptrb) {
+        fprintf(stderr, "dll_append - Error: Cannot append a list to itself\n");
+        return;
+    }
+    //nodes of `list b` must be released through `list a` from now on (its
+    //indexes go along with its iterators)
+    if (dll_nodesAdopt(alist, *listptrb) == -1) {
+        fprintf(stderr, "dll_append - Error: Cannot move the nodes of list b\n");
+        return;
+    }
+    if ((*listptrb)->unrolled != NULL && (*listptrb)->size > 0) {
+        dllunrolledptr aunrolled = alist->unrolled;
+        dllunrolledptr bunrolled = (*listptrb)->unrolled;
+        //relink the node chains, as for the plain nodes below
+        if (aunrolled->tail == NULL)
+            aunrolled->head = bunrolled->head;
+        else {
+            aunrolled->tail->next = bunrolled->head;
+            bunrolled->head->previous = aunrolled->tail;
+        }
+        aunrolled->tail = bunrolled->tail;
+        bunrolled->head = NULL;
+        bunrolled->tail = NULL;
+        alist->size += (*listptrb)->size;
+        DLL_STAT_PEAK(alist);
+    }
+    else if ((*listptrb)->size > 0) {
+        if (alist->size == 0)
+            alist->head = (*listptrb)->head;
+        else {
+            //make the tail of `list a` to point to the `list b` head
+            (alist->tail)->next = (*listptrb)->head;
+            //symmetrically
+            ((*listptrb)->head)->previous = alist->tail;
+        }
+        //update `list a` tail
+        alist->tail = (*listptrb)->tail;
+        //update sizes
+        alist->size += (*listptrb)->size;
+        DLL_STAT_PEAK(alist);
+        dll_nodesIndex(alist, (*listptrb)->head, (*listptrb)->tail);
+    }
+    //free `list b`
+    (*listptrb)->head = NULL;
+    (*listptrb)->tail = NULL;
+    (*listptrb)->size = 0;
+    dll_iteratorsFree(*listptrb);
+    dll_syncDestroy(*listptrb);
+    free((*listptrb)->unrolled);
+    free(*listptrb);
+    *listptrb = NULL;
+}
+
+/*
+ * Function responsible for merging the sorted `list b` into the sorted
+ * `list a` in a single pass, relinking the nodes of both lists (no node is
+ * allocated). Among equal elements, those of `list a` come first
+ * Upon return, the second list is going to be freed and nullified, as in
+ * dll_append
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned (both lists are left untouched)
+ */
+int dll_merge_sorted(list_t alist, list_t* listptrb,
+        int (*issmaller)(void*, void*))
+{
+    if (alist == NULL || listptrb == NULL || *listptrb == NULL) {
+        fprintf(stderr, "dll_merge_sorted - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(alist, "dll_merge_sorted") ||
+            dll_mapReadOnly(*listptrb, "dll_merge_sorted"))
+        return -1;
+    if (dll_unrolledUnsupported(alist, "dll_merge_sorted") ||
+            dll_unrolledUnsupported(*listptrb, "dll_merge_sorted"))
+        return -1;
+    if (dll_dequeUnsupported(alist, "dll_merge_sorted") ||
+            dll_dequeUnsupported(*listptrb, "dll_merge_sorted"))
+        return -1;
+    if (issmaller == NULL) {
+        fprintf(stderr, "dll_merge_sorted - Error: Comparison function is NULL\n");
+        return -1;
+    }
+    if (alist == *listptrb) {
+        fprintf(stderr, "dll_merge_sorted - Error: Cannot merge a list into "
+                "itself\n");
+        return -1;
+    }
+    list_t blist = *listptrb;
+    rwl_writeLock(alist->lock);
+    //nodes of `list b` must be released through `list a` from now on (its
+    //indexes go along with its iterators)
+    if (dll_nodesAdopt(alist, blist) == -1) {
+        fprintf(stderr, "dll_merge_sorted - Error: Cannot move the nodes of "
+                "list b\n");
+        rwl_writeUnlock(alist->lock);
+        return -1;
+    }
+    if (blist->size > 0) {
+        dllnodeptr current;
+        if (alist->hash != NULL)
+            for (current = blist->head; current != NULL; current = current->next)
+                if (dll_hashInsert(alist, current) == -1)
+                    break;
+        if (alist->size > 0)
+            dll_chainRelink(alist, dll_chainMerge(alist->head, blist->head,
+                    issmaller));
+        else {
+            alist->head = blist->head;
+            alist->tail = blist->tail;
+        }
+        alist->size += blist->size;
+        DLL_STAT_PEAK(alist);
+        //towers follow the order of the nodes, so the skip index is rebuilt
+        if (alist->index != NULL) {
+            dll_indexDestroy(alist);
+            dll_indexEnable(alist);
+        }
+    }
+    rwl_writeUnlock(alist->lock);
+    //free `list b`
+    blist->head = NULL;
+    blist->tail = NULL;
+    blist->size = 0;
+    dll_iteratorsFree(blist);
+    dll_syncDestroy(blist);
+    free(blist);
+    *listptrb = NULL;
+    return 0;
+}
+
+/*
+ * Function responsible for moving the elements of `list a` from the one of
+ * iterator `from` up to the one of iterator `to` (included) in front of the
+ * element of iterator `at` of `list b` (to its back, for an `at` of -1). The
+ * nodes are relinked, elements are neither copied nor reallocated
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned (both lists are left untouched)
+ */
+int dll_splice(list_t alist, IteratorID from, IteratorID to, list_t blist,
+        IteratorID at)
+{
+    if (alist == NULL || blist == NULL) {
+        fprintf(stderr, "dll_splice - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(alist, "dll_splice") ||
+            dll_mapReadOnly(blist, "dll_splice"))
+        return -1;
+    if (dll_unrolledUnsupported(alist, "dll_splice") ||
+            dll_unrolledUnsupported(blist, "dll_splice"))
+        return -1;
+    if (dll_dequeUnsupported(alist, "dll_splice") ||
+            dll_dequeUnsupported(blist, "dll_splice"))
+        return -1;
+    if (alist == blist) {
+        fprintf(stderr, "dll_splice - Error: Cannot splice a list into itself\n");
+        return -1;
+    }
+    if (alist->sync != NULL || blist->sync != NULL) {
+        fprintf(stderr, "dll_splice - Error: Not available for concurrent "
+                "lists\n");
+        return -1;
+    }
+    if (alist->arena != NULL) {
+        fprintf(stderr, "dll_splice - Error: Elements of list a may live in "
+                "its arena\n");
+        return -1;
+    }
+    if (alist->elem_size != blist->elem_size) {
+        fprintf(stderr, "dll_splice - Error: Lists hold elements of different "
+                "kind\n");
+        return -1;
+    }
+    dlliterator* first = dll_iteratorSlot(alist, from);
+    dlliterator* last = dll_iteratorSlot(alist, to);
+    if (first == NULL || last == NULL) {
+        fprintf(stderr, "dll_splice - Error: Invalid iterator of list a\n");
+        return -1;
+    }
+    dllnodeptr before = NULL;
+    if (at != -1) {
+        dlliterator* iterator = dll_iteratorSlot(blist, at);
+        if (iterator == NULL) {
+            fprintf(stderr, "dll_splice - Error: Invalid iterator of list b\n");
+            return -1;
+        }
+        before = iterator->node;
+    }
+    //count the range, which must run forward from `from` to `to`
+    dllnodeptr current = first->node;
+    int count = 1;
+    while (current != last->node) {
+        current = current->next;
+        if (current == NULL) {
+            fprintf(stderr, "dll_splice - Error: Iterator `to` is before "
+                    "iterator `from`\n");
+            return -1;
+        }
+        count++;
+    }
+    return dll_nodesMove(alist, first->node, last->node, count, blist, before,
+            0);
+}
+
+
+/*
+ * Function responsible for cutting the list in two at the element of the
+ * iterator: that element and the ones after it are moved to a new list of the
+ * same kind, stored in the 3rd argument. The nodes are relinked, elements are
+ * neither copied nor reallocated
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned (the list is left untouched)
+ */
+int dll_split_at(list_t list, IteratorID at, list_t* listptr_out)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_split_at - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_split_at"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_split_at"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_split_at"))
+        return -1;
+    if (listptr_out == NULL) {
+        fprintf(stderr, "dll_split_at - Error: Pointer to the new list is "
+                "NULL\n");
+        return -1;
+    }
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_split_at - Error: Not available for concurrent "
+                "lists\n");
+        return -1;
+    }
+    if (list->arena != NULL) {
+        fprintf(stderr, "dll_split_at - Error: Elements of the list may live "
+                "in its arena\n");
+        return -1;
+    }
+    dlliterator* iterator = dll_iteratorSlot(list, at);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_split_at - Error: Invalid iterator\n");
+        return -1;
+    }
+    //count the nodes from the iterator to the tail, walking both ways at
+    //once, so that it takes as long as the shorter of the two parts
+    dllnodeptr forward = iterator->node, backward = iterator->node;
+    int ahead = 1, behind = 0;
+    while (forward->next != NULL && backward->previous != NULL) {
+        forward = forward->next;
+        ahead++;
+        backward = backward->previous;
+        behind++;
+    }
+    int count = (forward->next == NULL) ? ahead : list->size - behind;
+    list_t out;
+    if (dll_initWith(&out, list->elem_size,
+            list->pool != NULL ? list->pool->chunk_nodes : 0) == -1)
+        return -1;
+    //the iterators on the moved part keep their slots (and IDs) in the new
+    //list, so it gets as many slots as the list has
+    if (list->iteratorsCapacity > 0) {
+        out->iteratorsArray = malloc(list->iteratorsCapacity *
+                sizeof(dlliterator));
+        if (out->iteratorsArray == NULL) {
+            perror("dll_split_at - Error: Cannot allocate iterators");
+            dll_destroy(&out, NULL);
+            return -1;
+        }
+        out->iteratorsCapacity = list->iteratorsCapacity;
+        int slot;
+        for (slot = 0; slot < out->iteratorsCapacity; slot++) {
+            (out->iteratorsArray[slot]).generation = 0;
+            (out->iteratorsArray[slot]).next_free = -1;
+        }
+    }
+    if (dll_nodesMove(list, iterator->node, list->tail, count, out, NULL,
+            1) == -1) {
+        dll_destroy(&out, NULL);
+        return -1;
+    }
+    //chain the slots that no iterator migrated to
+    int slot;
+    for (slot = out->iteratorsCapacity - 1; slot >= 0; slot--)
+        if ((out->iteratorsArray[slot]).next_free != DLL_ITER_LIVE) {
+            (out->iteratorsArray[slot]).next_free = out->iteratorsFree;
+            out->iteratorsFree = slot;
+        }
+    *listptr_out = out;
+    return 0;
+}
+
+
+/*
+ * Function responsible for sorting the list in ascending order, as defined
+ * by issmaller, with a stable merge sort that relinks the nodes in place
+ * (elements are neither copied nor reallocated and iterators keep pointing
+ * to the same elements)
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_sort(list_t list, int (*issmaller)(void*, void*))
+{
+    return dll_sort_parallel(list, issmaller, 1);
+}
+
+
+// Arguments of the threads of dll_sort_parallel
+typedef struct
+{
+    dllnodeptr first, second;
+    int (*issmaller)(void*, void*);
+} dllsortjob;
+
+void* dll_sortWorker(void* arg)
+{
+    dllsortjob* job = arg;
+    if (job->second == NULL)
+        job->first = dll_chainSort(job->first, job->issmaller);
+    else
+        job->first = dll_chainMerge(job->first, job->second, job->issmaller);
+    return NULL;
+}
+
+
+/*
+ * Function responsible for sorting the list like dll_sort does, using
+ * `nthreads` threads: the list is cut into as many runs, which are sorted
+ * concurrently and then merged pairwise (also concurrently)
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_sort_parallel(list_t list, int (*issmaller)(void*, void*), int nthreads)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_sort - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_sort"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_sort"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_sort"))
+        return -1;
+    if (issmaller == NULL) {
+        fprintf(stderr, "dll_sort - Error: Comparison function is NULL\n");
+        return -1;
+    }
+    rwl_writeLock(list->lock);
+    if (list->size < 2) {
+        rwl_writeUnlock(list->lock);
+        return 0;
+    }
+    //runs of less than a few thousand nodes are not worth a thread
+    if (nthreads > list->size / 4096)
+        nthreads = list->size / 4096;
+    if (nthreads <= 1) {
+        list->tail->next = NULL;
+        dll_chainRelink(list, dll_chainSort(list->head, issmaller));
+    }
+    else {
+        dllsortjob* jobs = malloc(nthreads * sizeof(dllsortjob));
+        if (jobs == NULL) {
+            perror("dll_sort_parallel - Error: ");
+            rwl_writeUnlock(list->lock);
+            return -1;
+        }
+        //cut the list into runs of (almost) equal length
+        dllnodeptr current = list->head;
+        int run, runs = nthreads;
+        for (run = 0; run < runs; run++) {
+            int length = list->size / runs + (run < list->size % runs);
+            jobs[run].first = current;
+            jobs[run].second = NULL;
+            jobs[run].issmaller = issmaller;
+            while (--length > 0)
+                current = current->next;
+            dllnodeptr next = current->next;
+            current->next = NULL;
+            current = next;
+        }
+        dll_runParallel(&dll_sortWorker, jobs, sizeof(dllsortjob), runs);
+        //merge neighbouring runs, halving their number at every round
+        while (runs > 1) {
+            int pairs = runs / 2;
+            for (run = 0; run < pairs; run++) {
+                jobs[run].first = jobs[2 * run].first;
+                jobs[run].second = jobs[2 * run + 1].first;
+            }
+            dll_runParallel(&dll_sortWorker, jobs, sizeof(dllsortjob), pairs);
+            if (runs % 2 == 1) {
+                jobs[pairs].first = jobs[runs - 1].first;
+                jobs[pairs].second = NULL;
+            }
+            runs = pairs + runs % 2;
+        }
+        dll_chainRelink(list, jobs[0].first);
+        free(jobs);
+    }
+    //towers follow the order of the nodes, so the skip index is rebuilt
+    if (list->index != NULL) {
+        dll_indexDestroy(list);
+        dll_indexEnable(list);
+    }
+    rwl_writeUnlock(list->lock);
+    return 0;
+}
+
+// Arguments of the threads of dll_parallel_for_each and dll_reduce
+typedef struct
+{
+    dllnodeptr first;
+    int count;
+    void (*fn)(void*, void*);
+    void* ctx;
+    int fold;           // fn takes ctx (the accumulator) first, for dll_reduce
+} dllforeachjob;
+
+void* dll_forEachWorker(void* arg)
+{
+    dllforeachjob* job = arg;
+    dllnodeptr current = job->first;
+    int i;
+    if (job->fold)
+        for (i = 0; i < job->count; i++, current = current->next)
+            (*job->fn)(job->ctx, current->data);
+    else
+        for (i = 0; i < job->count; i++, current = current->next)
+            (*job->fn)(current->data, job->ctx);
+    return NULL;
+}
+
+/*
+ * Cuts the list into `runs` runs of consecutive nodes of (almost) equal
+ * length, returning as many jobs with only their first node and length set
+ * (NULL on failure). The runs are found in a single pass over the list, or
+ * through the skip index if the list has one
+ */
+dllforeachjob* dll_forEachCut(list_t list, int runs)
+{
+    dllforeachjob* jobs = malloc(runs * sizeof(dllforeachjob));
+    if (jobs == NULL)
+        return NULL;
+    dllnodeptr current = list->head;
+    int run, position = 0;
+    for (run = 0; run < runs; run++) {
+        int length = list->size / runs + (run < list->size % runs);
+        if (list->index != NULL && run > 0)
+            current = dll_indexNodeAt(list, position);
+        jobs[run].first = current;
+        jobs[run].count = length;
+        position += length;
+        if (list->index == NULL && run < runs - 1)
+            while (length-- > 0)
+                current = current->next;
+    }
+    return jobs;
+}
+
+
+/*
+ * Function responsible for calling fn on every element of the list (along
+ * with ctx), using up to `nthreads` threads: the list is cut into as many
+ * runs of consecutive elements, whose elements are visited in list order,
+ * one run per thread
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_parallel_for_each(list_t list, void (*fn)(void*, void*), int nthreads,
+        void* ctx)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_parallel_for_each - Error: DLList has not been "
+                "initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_parallel_for_each"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_parallel_for_each"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_parallel_for_each"))
+        return -1;
+    if (fn == NULL) {
+        fprintf(stderr, "dll_parallel_for_each - Error: Function given is "
+                "NULL\n");
+        return -1;
+    }
+    //the other methods of concurrent lists hold the read lock while they
+    //change the list, so those lists are locked as a whole
+    if (list->sync != NULL)
+        rwl_writeLock(list->lock);
+    else
+        rwl_readLock(list->lock);
+    if (nthreads > list->size)
+        nthreads = list->size;
+    if (nthreads < 1)
+        nthreads = 1;
+    dllforeachjob* jobs = dll_forEachCut(list, nthreads);
+    if (jobs == NULL) {
+        perror("dll_parallel_for_each - Error: ");
+        if (list->sync != NULL)
+            rwl_writeUnlock(list->lock);
+        else
+            rwl_readUnlock(list->lock);
+        return -1;
+    }
+    int run;
+    for (run = 0; run < nthreads; run++) {
+        jobs[run].fn = fn;
+        jobs[run].ctx = ctx;
+        jobs[run].fold = 0;
+    }
+    dll_runParallel(&dll_forEachWorker, jobs, sizeof(dllforeachjob), nthreads);
+    free(jobs);
+    if (list->sync != NULL)
+        rwl_writeUnlock(list->lock);
+    else
+        rwl_readUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Function responsible for folding the elements of the list into the
+ * accumulator `acc` (of `acc_size` bytes) with combine(acc, element), using
+ * up to `nthreads` threads: the list is cut into as many runs, each one is
+ * folded into a copy of the initial accumulator on a thread of its own, and
+ * the partial results are then merged into `acc` with merge(acc, partial), in
+ * list order
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_reduce(list_t list, void* acc, size_t acc_size,
+        void (*combine)(void*, void*), void (*merge)(void*, void*),
+        int nthreads)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_reduce - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (acc == NULL || combine == NULL) {
+        fprintf(stderr, "dll_reduce - Error: Accumulator or combine function "
+                "given is NULL\n");
+        return -1;
+    }
+    if (list->map != NULL) {
+        fprintf(stderr, "dll_reduce - Error: Not available for mapped lists\n");
+        return -1;
+    }
+    if (dll_unrolledUnsupported(list, "dll_reduce"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_reduce"))
+        return -1;
+    //partial results cannot be put together without merge
+    if (merge == NULL)
+        nthreads = 1;
+    if (list->sync != NULL)
+        rwl_writeLock(list->lock);
+    else
+        rwl_readLock(list->lock);
+    if (nthreads > list->size)
+        nthreads = list->size;
+    if (nthreads < 1)
+        nthreads = 1;
+    //the first run is folded straight into `acc`, the others into copies of
+    //its initial value
+    char* partials = NULL;
+    dllforeachjob* jobs = dll_forEachCut(list, nthreads);
+    if (jobs != NULL && nthreads > 1) {
+        partials = malloc((nthreads - 1) * acc_size);
+        if (partials == NULL) {
+            free(jobs);
+            jobs = NULL;
+        }
+    }
+    if (jobs == NULL) {
+        perror("dll_reduce - Error: ");
+        if (list->sync != NULL)
+            rwl_writeUnlock(list->lock);
+        else
+            rwl_readUnlock(list->lock);
+        return -1;
+    }
+    int run;
+    for (run = 0; run < nthreads; run++) {
+        jobs[run].fn = combine;
+        jobs[run].fold = 1;
+        if (run == 0)
+            jobs[run].ctx = acc;
+        else {
+            jobs[run].ctx = partials + (run - 1) * acc_size;
+            memcpy(jobs[run].ctx, acc, acc_size);
+        }
+    }
+    dll_runParallel(&dll_forEachWorker, jobs, sizeof(dllforeachjob), nthreads);
+    for (run = 1; run < nthreads; run++)
+        (*merge)(acc, jobs[run].ctx);
+    free(partials);
+    free(jobs);
+    if (list->sync != NULL)
+        rwl_writeUnlock(list->lock);
+    else
+        rwl_readUnlock(list->lock);
+    return 0;
+}
+
+
+/*
+ * Function responsible for building a skip index over the nodes of the list
+ * It is kept up to date by every insert and delete, and lets dll_insert_sorted
+ * and dll_search_sorted find their place in O(log n) comparisons, as well as
+ * dll_get_at, dll_insert_at and dll_delete_at find their position in O(log n)
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_indexEnable(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_indexEnable - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_indexEnable"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_indexEnable"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_indexEnable"))
+        return -1;
+    if (list->index != NULL)
+        return 0;
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_indexEnable - Error: Not available for "
+                "concurrent lists\n");
+        return -1;
+    }
+    list->index = malloc(sizeof(struct DoublyLinkedListIndex));
+    if (list->index == NULL) {
+        perror("dll_indexEnable - Error: ");
+        return -1;
+    }
+    list->index->seed = 2463534242u;
+    list->index->header = dll_towerCreate(NULL, DLL_INDEX_MAX_LEVEL);
+    if (list->index->header == NULL) {
+        perror("dll_indexEnable - Error: ");
+        free(list->index);
+        list->index = NULL;
+        return -1;
+    }
+    if (list->size > 0)
+        return dll_indexLink(list, list->head, list->tail);
+    return 0;
+}
+
+
+/*
+ * Function responsible for dropping the skip index of the list
+ */
+void dll_indexDisable(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_indexDisable - Error: DLList has not been initialized\n");
+        return;
+    }
+    dll_indexDestroy(list);
+}
+
+
+/*
+ * Function responsible for building a hash index over the elements of the
+ * list, with the given hash function. Keyed operations (dll_edit_data,
+ * dll_delete, dll_insert_before, dll_insert_after) then find their element in
+ * O(1) expected time
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_hashEnable(list_t list, unsigned int (*hash)(void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_hashEnable - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_hashEnable"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_hashEnable"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_hashEnable"))
+        return -1;
+    if (hash == NULL) {
+        fprintf(stderr, "dll_hashEnable - Error: Hash function given is NULL\n");
+        return -1;
+    }
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_hashEnable - Error: Not available for "
+                "concurrent lists\n");
+        return -1;
+    }
+    dll_hashDestroy(list);
+    list->hash = malloc(sizeof(struct DoublyLinkedListHash));
+    if (list->hash == NULL) {
+        perror("dll_hashEnable - Error: ");
+        return -1;
+    }
+    list->hash->slots = NULL;
+    list->hash->capacity = 0;
+    list->hash->count = 0;
+    list->hash->hash = hash;
+    //start with a table that is at most half full
+    unsigned int capacity = 16;
+    while (capacity < 2 * (unsigned int) list->size)
+        capacity *= 2;
+    if (dll_hashResize(list->hash, capacity) == -1) {
+        perror("dll_hashEnable - Error: ");
+        dll_hashDestroy(list);
+        return -1;
+    }
+    if (list->size > 0)
+        return dll_nodesIndex(list, list->head, list->tail);
+    return 0;
+}
+
+
+/*
+ * Function responsible for dropping the hash index of the list
+ */
+void dll_hashDisable(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_hashDisable - Error: DLList has not been initialized\n");
+        return;
+    }
+    dll_hashDestroy(list);
+}
+
+
+/*
+ * Function responsible for making the keyed searches of the list (edit_data,
+ * delete, insert_before and insert_after) remember the node they found, and
+ * start the next search there, looking on both sides of it. Successive
+ * accesses to neighbouring elements cost O(distance) instead of O(n), while
+ * a key that is not in the list still costs a full scan. With duplicate keys
+ * the match nearest to the finger is picked instead of the first one
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_fingerEnable(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_fingerEnable - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_fingerEnable"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_fingerEnable"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_fingerEnable"))
+        return -1;
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_fingerEnable - Error: Not available for "
+                "concurrent lists\n");
+        return -1;
+    }
+    list->use_finger = 1;
+    return 0;
+}
+
+
+/*
+ * Function responsible for making the keyed searches of the list start at
+ * the head again
+ */
+void dll_fingerDisable(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_fingerDisable - Error: DLList has not been initialized\n");
+        return;
+    }
+    list->use_finger = 0;
+    list->finger = NULL;
+}
+
+
+/*
+ * Function responsible for finding the first element of a sorted list that is
+ * equal to `key`, in the sense of issmaller (neither is smaller than the
+ * other). With a skip index the search takes O(log n) comparisons, otherwise
+ * the list is scanned from the head until the key is passed
+ * Return values:
+ *      [*] On success, the object is returned
+ *      [*] On element not found or on error, NULL is returned
+ */
+void* dll_search_sorted(list_t list, void* key, int (*issmaller)(void*, void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_search_sorted - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    if (dll_dequeUnsupported(list, "dll_search_sorted"))
+        return NULL;
+    if (key == NULL) {
+        fprintf(stderr, "dll_search_sorted - Error: Key given is NULL\n");
+        return NULL;
+    }
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_search_sorted - Error: Not available for "
+                "concurrent lists\n");
+        return NULL;
+    }
+    dllnodeptr current = NULL;
+    if (list->map != NULL) {
+        //mapped nodes are laid out in list order, search them as an array
+        int low = 0, high = list->size;
+        DLL_STAT(list, searches, 1);
+        while (low < high) {
+            int middle = low + (high - low) / 2;
+            DLL_STAT(list, search_visits, 1);
+            DLL_STAT(list, compares, 1);
+            if ((*issmaller)(dll_mapNodeAt(list, middle)->payload, key))
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        if (low == list->size)
+            return NULL;
+        void* data = dll_mapNodeAt(list, low)->payload;
+        DLL_STAT(list, compares, 1);
+        return (*issmaller)(key, data) ? NULL : data;
+    }
+    if (list->unrolled != NULL) {
+        void* data = dll_unrolledSeek(list, key, issmaller);
+        if (data == NULL)
+            return NULL;
+        DLL_STAT(list, compares, 1);
+        return (*issmaller)(key, data) ? NULL : data;
+    }
+    if (list->index != NULL)
+        current = dll_indexSeek(list, key, issmaller, 0);
+    //the node found is smaller than the key, start right after it
+    current = (current == NULL) ? list->head : current->next;
+    DLL_STAT(list, searches, 1);
+    while (current != NULL) {
+        DLL_STAT(list, search_visits, 1);
+        DLL_STAT(list, compares, 1);
+        if (!(*issmaller)(current->data, key))
+            break;
+        current = current->next;
+    }
+    if (current == NULL)
+        return NULL;
+    DLL_STAT(list, compares, 1);
+    if ((*issmaller)(key, current->data))
+        return NULL;
+    return current->data;
+}
+
+
+/*
+ * Function that returns the element at the given position of the list (0 for
+ * the head). The list is walked from the nearer end, or, with a skip index
+ * (see dll_indexEnable), the position is found in O(log n)
+ * Return values:
+ *      [*] On success, the object is returned
+ *      [*] On position out of range or on error, NULL is returned
+ */
+void* dll_get_at(list_t list, int position)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_get_at - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    if (dll_dequeUnsupported(list, "dll_get_at"))
+        return NULL;
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_get_at - Error: Not available for concurrent "
+                "lists\n");
+        return NULL;
+    }
+    if (position < 0 || position >= list->size)
+        return NULL;
+    if (list->map != NULL)
+        return dll_mapNodeAt(list, position)->payload;
+    if (list->unrolled != NULL) {
+        int offset;
+        return dll_unrolledAt(list, position, &offset)->items[offset];
+    }
+    return dll_nodeAt(list, position)->data;
+}
+
+
+/*
+ * Function responsible for deleting the element that contains the `key`
+ * given as a 2nd parameter
+ * Also, two pointers to functions needed, the 1st for identifying the
+ * correct element and the second one for freeing it
+ * Return values:
+ *      [*] On success,             0 is returned
+ *      [*] On element not found,   1 is returned
+ *      [*] On error,               -1 is returned
+ */
+int dll_delete(list_t list, void* key, int (*is_equal)(void*, void*),
+                void (*free_data)(void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_delete - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_delete"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_delete"))
+        return -1;
+    if (key == NULL) {
+        fprintf(stderr, "dll_delete - Error: Key parameter is NULL\n");
+        return -1;
+    }
+    if(dll_isempty(list)) {
+        fprintf(stderr, "dll_delete - Error: DLList is empty\n");
+        return 1;
+    }
+    else if (list->sync != NULL) {
+        dllnodeptr deletion = dll_syncDetachKey(list, key, is_equal);
+        if (deletion == NULL)
+            return 1;
+        DLL_STAT(list, deletes_key, 1);
+        dll_nodeDelete(list, deletion, free_data);
+        return 0;
+    }
+    else if (list->unrolled != NULL) {
+        dllunodeptr node;
+        int offset = dll_unrolledFind(list, key, is_equal, &node);
+        if (offset == -1)
+            return 1;
+        DLL_STAT(list, deletes_key, 1);
+        void* data = dll_unrolledRemove(list, node, offset);
+        if (free_data != NULL)
+            (*free_data)(data);
+        return 0;
+    }
+    else {
+        //find the element (if it exits and delete it)
+        dllnodeptr current = dll_nodeFind(list, key, is_equal);
+        if (current == NULL) {
+            //element wasn't found
+            return 1;
+        }
+        DLL_STAT(list, deletes_key, 1);
+        if (current == list->head) {
+            if (current != list->tail) {
+                //first node doesn't have previous
+                list->size--;
+                dll_iteratorUpdate(list, current, current->next);
+                (current->next)->previous = NULL;
+                list->head = current->next;
+                dll_nodeDelete(list, current, free_data);
+                current = NULL;
+            }
+            else {
+                //case in which we are deleting the one and only
+                //element of the list
+                list->head = NULL;
+                list->tail = NULL;
+                list->size--;
+                dll_nodeDelete(list, current, free_data);
+                current = NULL;
+                dll_iteratorUpdate(list, NULL, NULL);
+            }
+        }
+        else if (current == list->tail) {
+            list->size--;
+            dll_iteratorUpdate(list, current, current->previous);
+            list->tail = current->previous;
+            //last node doesn't have next
+            (current->previous)->next = NULL;
+            dll_nodeDelete(list, current, free_data);
+            current = NULL;
+        }
+        else {
+            list->size--;
+            dll_iteratorUpdate(list, current, current->next);
+            (current->previous)->next = current->next;
+            (current->next)->previous = current->previous;
+            dll_nodeDelete(list, current, free_data);
+            current = NULL;
+        }
+        return 0;
+    }
+}
+
+
+/*
+ * Function responsible for deleting the element at the given position of the
+ * list (0 for the head), found as in dll_get_at. Iterators pointing to it move
+ * on to the next element (or the previous one, for the tail)
+ * Return values:
+ *      [*] On success,                 0 is returned
+ *      [*] On position out of range,   1 is returned
+ *      [*] On error,                   -1 is returned
+ */
+int dll_delete_at(list_t list, int position, void (*free_data)(void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_delete_at - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_delete_at"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_delete_at"))
+        return -1;
+    if (list->sync != NULL) {
+        fprintf(stderr, "dll_delete_at - Error: Not available for concurrent "
+                "lists\n");
+        return -1;
+    }
+    if (position < 0 || position >= list->size)
+        return 1;
+    DLL_STAT(list, deletes_at, 1);
+    if (list->unrolled != NULL) {
+        int offset;
+        dllunodeptr node = dll_unrolledAt(list, position, &offset);
+        void* data = dll_unrolledRemove(list, node, offset);
+        if (free_data != NULL)
+            (*free_data)(data);
+        return 0;
+    }
+    dllnodeptr current = dll_nodeAt(list, position);
+    list->size--;
+    dll_iteratorUpdate(list, current,
+            current->next != NULL ? current->next : current->previous);
+    if (current->previous == NULL)
+        list->head = current->next;
+    else
+        (current->previous)->next = current->next;
+    if (current->next == NULL)
+        list->tail = current->previous;
+    else
+        (current->next)->previous = current->previous;
+    dll_nodeDelete(list, current, free_data);
+    return 0;
+}
+
+
+/*
+ * Function responsible for deleting every element for which pred(element,
+ * ctx) is true, in a single pass. Iterators pointing to deleted elements move
+ * on to the next element that stays (the last one, if none follows). If
+ * `removed` is not NULL, the deleted elements are handed back in an array
+ * stored there (NULL if none), instead of being freed with free_data
+ * Return values:
+ *      [*] On success, the number of deleted elements is returned
+ *      [*] On failure, -1 is returned (the list is left untouched)
+ */
+int dll_remove_if(list_t list, int (*pred)(void*, void*), void* ctx,
+        void (*free_data)(void*), void*** removed)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_remove_if - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_remove_if"))
+        return -1;
+    if (dll_unrolledUnsupported(list, "dll_remove_if"))
+        return -1;
+    if (dll_dequeUnsupported(list, "dll_remove_if"))
+        return -1;
+    if (pred == NULL) {
+        fprintf(stderr, "dll_remove_if - Error: Predicate given is NULL\n");
+        return -1;
+    }
+    if (removed != NULL && list->elem_size > 0) {
+        fprintf(stderr, "dll_remove_if - Error: Elements of inline lists "
+                "cannot be handed back\n");
+        return -1;
+    }
+    rwl_writeLock(list->lock);
+    //room for every element, so that the pass itself cannot fail
+    void** batch = NULL;
+    if (removed != NULL && list->size > 0) {
+        batch = malloc(list->size * sizeof(void*));
+        if (batch == NULL) {
+            perror("dll_remove_if - Error: ");
+            rwl_writeUnlock(list->lock);
+            return -1;
+        }
+    }
+    //the skip index is rebuilt afterwards, instead of unlinking the nodes
+    //one by one
+    int reindex = (list->index != NULL);
+    dll_indexDestroy(list);
+    //iterators (and the finger) of deleted nodes are gathered until the next
+    //node that stays comes up
+    dlliterator* iterators = list->iteratorsArray;
+    int pending = -1, pending_last = -1, finger_pending = 0, count = 0;
+    dllnodeptr current = list->head, kept = NULL;
+    while (current != NULL) {
+        dllnodeptr next = current->next;
+        if (!(*pred)(current->data, ctx)) {
+            if (pending != -1) {
+                dll_iteratorsAttach(list, pending, pending_last, current);
+                pending = -1;
+            }
+            if (finger_pending) {
+                list->finger = current;
+                finger_pending = 0;
+            }
+            //link the node after the last one kept
+            if (current->previous != kept) {
+                current->previous = kept;
+                if (kept == NULL)
+                    list->head = current;
+                else
+                    kept->next = current;
+            }
+            kept = current;
+        }
+        else {
+            if (current->iterators != -1) {
+                int slot = current->iterators;
+                if (pending == -1)
+                    pending = slot;
+                else {
+                    iterators[pending_last].next_on_node = slot;
+                    iterators[slot].previous_on_node = pending_last;
+                }
+                while (iterators[slot].next_on_node != -1)
+                    slot = iterators[slot].next_on_node;
+                pending_last = slot;
+                current->iterators = -1;
+            }
+            if (list->finger == current) {
+                list->finger = NULL;
+                finger_pending = 1;
+            }
+            if (list->hash != NULL)
+                dll_hashRemove(list, current);
+            if (batch != NULL)
+                batch[count] = current->data;
+            else
+                dll_nodeFreeData(list, current, free_data);
+            dll_nodeRelease(list, current);
+            count++;
+        }
+        current = next;
+    }
+    if (kept == NULL)
+        list->head = NULL;
+    else
+        kept->next = NULL;
+    list->tail = kept;
+    list->size -= count;
+    DLL_STAT(list, deletes_if, count);
+    if (finger_pending)
+        list->finger = kept;
+    if (pending != -1) {
+        if (kept != NULL)
+            dll_iteratorsAttach(list, pending, pending_last, kept);
+        else
+            //the nodes of the iterators are gone, they are only released
+            dll_iteratorDeleteAll(list);
+    }
+    if (reindex)
+        dll_indexEnable(list);
+    rwl_writeUnlock(list->lock);
+    if (removed != NULL) {
+        if (count == 0) {
+            free(batch);
+            batch = NULL;
+        }
+        else {
+            //give back the unused room
+            void** tmp = realloc(batch, count * sizeof(void*));
+            if (tmp != NULL)
+                batch = tmp;
+        }
+        *removed = batch;
+    }
+    return count;
+}
+
+
+/*
+ * Deletes the tail element of the list
+ */
+void dll_delete_back(list_t list, void (*free_data)(void* data))
+{
+    if (dll_mapReadOnly(list, "dll_delete_back"))
+        return;
+    if (list->deque != NULL) {
+        //inline elements go away along with their node
+        void* data = NULL;
+        if (dll_dequePop(list, DLL_DEQUE_BACK,
+                list->elem_size == 0 ? &data : NULL) == 0) {
+            DLL_STAT(list, deletes_back, 1);
+            if (data != NULL && free_data != NULL)
+                (*free_data)(data);
+        }
+        return;
+    }
+    if (list->sync != NULL) {
+        dllnodeptr deletion = dll_syncDetachBack(list);
+        if (deletion != NULL) {
+            DLL_STAT(list, deletes_back, 1);
+            dll_nodeDelete(list, deletion, free_data);
+        }
+        return;
+    }
+    if (list->unrolled != NULL) {
+        if (list->size == 0)
+            return;
+        DLL_STAT(list, deletes_back, 1);
+        void* data = dll_unrolledRemove(list, list->unrolled->tail,
+                list->unrolled->tail->count - 1);
+        if (free_data != NULL)
+            (*free_data)(data);
+        return;
+    }
+    DLL_STAT(list, deletes_back, 1);
+    list->size--;
+    dllnodeptr deletion = list->tail;
+    if (list->size > 0) {
+        //take care of iterators that point to tail, so as to point to the new tail
+        //element of the list
+        dll_iteratorUpdate(list, deletion, deletion->previous);
+        list->tail = (list->tail)->previous;
+        (list->tail)->next = NULL;
+        dll_nodeDelete(list, deletion, free_data);
+        deletion = NULL;
+    }
+    else {
+        // list is empty
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        list->head = NULL;
+        list->tail = NULL;
+        dll_nodeDelete(list, deletion, free_data);
+        deletion = NULL;
+    }
+}
+
+
+/*
+ * Deletes the head element of the list
+ */
+void dll_delete_front(list_t list, void (*free_data)(void* data))
+{
+    if (dll_mapReadOnly(list, "dll_delete_front"))
+        return;
+    if (list->deque != NULL) {
+        //inline elements go away along with their node
+        void* data = NULL;
+        if (dll_dequePop(list, DLL_DEQUE_FRONT,
+                list->elem_size == 0 ? &data : NULL) == 0) {
+            DLL_STAT(list, deletes_front, 1);
+            if (data != NULL && free_data != NULL)
+                (*free_data)(data);
+        }
+        return;
+    }
+    if (list->sync != NULL) {
+        dllnodeptr deletion = dll_syncDetachFront(list);
+        if (deletion != NULL) {
+            DLL_STAT(list, deletes_front, 1);
+            dll_nodeDelete(list, deletion, free_data);
+        }
+        return;
+    }
+    if (list->unrolled != NULL) {
+        if (list->size == 0)
+            return;
+        DLL_STAT(list, deletes_front, 1);
+        void* data = dll_unrolledRemove(list, list->unrolled->head,
+                0);
+        if (free_data != NULL)
+            (*free_data)(data);
+        return;
+    }
+    DLL_STAT(list, deletes_front, 1);
+    list->size--;
+    dllnodeptr deletion = list->head;
+    if (list->size > 0) {
+        //take care of iterators that point to head, so as they point to the next
+        //element (new head) of the list
+        dll_iteratorUpdate(list, deletion, deletion->next);
+        list->head = (list->head)->next;
+        (list->head)->previous = NULL;
+        dll_nodeDelete(list, deletion, free_data);
+        deletion = NULL;
+    }
+    else {
+        // list is empty
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        list->head = NULL;
+        list->tail = NULL;
+        dll_nodeDelete(list, deletion, free_data);
+        deletion = NULL;
+    }
+}
+
+
+/*
+ * Unlinks the head element of the list and hands it over to the caller,
+ * instead of freeing it. Not available for inline lists (see
+ * dll_pop_front_into)
+ * Return values:
+ *      [*] On success, the element is returned
+ *      [*] On empty list or on error, NULL is returned
+ */
+void* dll_pop_front(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_pop_front - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    if (list->elem_size > 0) {
+        fprintf(stderr, "dll_pop_front - Error: Elements of inline lists "
+                "cannot be handed over\n");
+        return NULL;
+    }
+    if (list->deque != NULL) {
+        void* data;
+        if (dll_dequePop(list, DLL_DEQUE_FRONT, &data) != 0)
+            return NULL;
+        DLL_STAT(list, deletes_front, 1);
+        return data;
+    }
+    if (list->sync != NULL) {
+        dllnodeptr first = dll_syncDetachFront(list);
+        if (first == NULL)
+            return NULL;
+        DLL_STAT(list, deletes_front, 1);
+        void* data = first->data;
+        dll_nodeDelete(list, first, NULL);
+        return data;
+    }
+    if (dll_isempty(list))
+        return NULL;
+    if (list->unrolled != NULL) {
+        DLL_STAT(list, deletes_front, 1);
+        return dll_unrolledRemove(list, list->unrolled->head, 0);
+    }
+    void* data = list->head->data;
+    //a NULL free_data function leaves the element alone
+    dll_delete_front(list, NULL);
+    return data;
+}
+
+
+/*
+ * Unlinks the tail element of the list and hands it over to the caller,
+ * instead of freeing it. Not available for inline lists (see
+ * dll_pop_back_into)
+ * Return values:
+ *      [*] On success, the element is returned
+ *      [*] On empty list or on error, NULL is returned
+ */
+void* dll_pop_back(list_t list)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_pop_back - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    if (list->elem_size > 0) {
+        fprintf(stderr, "dll_pop_back - Error: Elements of inline lists "
+                "cannot be handed over\n");
+        return NULL;
+    }
+    if (list->deque != NULL) {
+        void* data;
+        if (dll_dequePop(list, DLL_DEQUE_BACK, &data) != 0)
+            return NULL;
+        DLL_STAT(list, deletes_back, 1);
+        return data;
+    }
+    if (list->sync != NULL) {
+        dllnodeptr last = dll_syncDetachBack(list);
+        if (last == NULL)
+            return NULL;
+        DLL_STAT(list, deletes_back, 1);
+        void* data = last->data;
+        dll_nodeDelete(list, last, NULL);
+        return data;
+    }
+    if (dll_isempty(list))
+        return NULL;
+    if (list->unrolled != NULL) {
+        DLL_STAT(list, deletes_back, 1);
+        return dll_unrolledRemove(list, list->unrolled->tail,
+                list->unrolled->tail->count - 1);
+    }
+    void* data = list->tail->data;
+    dll_delete_back(list, NULL);
+    return data;
+}
+
+
+/*
+ * Unlinks the head element of an inline list, copying it into `out` (of at
+ * least elem_size bytes) before its node is released. This is the pop of
+ * inline lists, which have no object to hand over
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On empty list, 1 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_pop_front_into(list_t list, void* out)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_pop_front_into - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (list->elem_size == 0 || out == NULL) {
+        fprintf(stderr, "dll_pop_front_into - Error: Only inline lists copy "
+                "their elements out\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_pop_front_into"))
+        return -1;
+    if (list->deque != NULL) {
+        int retval = dll_dequePop(list, DLL_DEQUE_FRONT, out);
+        if (retval == 0)
+            DLL_STAT(list, deletes_front, 1);
+        return retval;
+    }
+    if (list->sync != NULL) {
+        dllnodeptr first = dll_syncDetachFront(list);
+        if (first == NULL)
+            return 1;
+        DLL_STAT(list, deletes_front, 1);
+        memcpy(out, first->data, list->elem_size);
+        dll_nodeDelete(list, first, NULL);
+        return 0;
+    }
+    if (dll_isempty(list))
+        return 1;
+    memcpy(out, list->head->data, list->elem_size);
+    dll_delete_front(list, NULL);
+    return 0;
+}
+
+
+/*
+ * Same as dll_pop_front_into, for the tail element of the inline list
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On empty list, 1 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_pop_back_into(list_t list, void* out)
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_pop_back_into - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (list->elem_size == 0 || out == NULL) {
+        fprintf(stderr, "dll_pop_back_into - Error: Only inline lists copy "
+                "their elements out\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_pop_back_into"))
+        return -1;
+    if (list->deque != NULL) {
+        int retval = dll_dequePop(list, DLL_DEQUE_BACK, out);
+        if (retval == 0)
+            DLL_STAT(list, deletes_back, 1);
+        return retval;
+    }
+    if (list->sync != NULL) {
+        dllnodeptr last = dll_syncDetachBack(list);
+        if (last == NULL)
+            return 1;
+        DLL_STAT(list, deletes_back, 1);
+        memcpy(out, last->data, list->elem_size);
+        dll_nodeDelete(list, last, NULL);
+        return 0;
+    }
+    if (dll_isempty(list))
+        return 1;
+    memcpy(out, list->tail->data, list->elem_size);
+    dll_delete_back(list, NULL);
+    return 0;
+}
+
+
+/*
+ * Function responsible for deleting all the elements of the list, which stays
+ * ready for use, with its indexes and finger still enabled. Elements are
+ * freed with free_data, unless it is NULL or the list is inline; then the
+ * nodes of pooled lists are not visited at all, as they are released along
+ * with the chunks of the pool (and the blocks of arena lists)
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned (the list is cleared, but has lost its
+ *          skip index)
+ */
+int dll_clear(list_t list, void (*free_data)(void*))
+{
+    if (list == NULL) {
+        fprintf(stderr, "dll_clear - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_clear"))
+        return -1;
+    rwl_writeLock(list->lock);
+    //iterators and towers point to the nodes, so they go first
+    dll_iteratorDeleteAll(list);
+    int indexed = (list->index != NULL);
+    dll_indexDestroy(list);
+    if (list->hash != NULL) {
+        memset(list->hash->slots, 0,
+                list->hash->capacity * sizeof(dllhashslot));
+        list->hash->count = 0;
+    }
+    dll_nodesClear(list, free_data);
+    int retval = 0;
+    if (indexed)
+        retval = dll_indexEnable(list);
+    rwl_writeUnlock(list->lock);
+    return retval;
+}
+
+
+/*
+ * Function responsible for freeing all the allocated memory
+ */
+void dll_destroy(list_t *dllptr_addr, void (*free_data)(void* data))
+{
+    if (*dllptr_addr == NULL) {
+        fprintf(stderr, "dll_destroy - Error: DLList has not been initialized\n");
+        return;
+    }
+    //free the indexes, if there are any
+    dll_indexDestroy(*dllptr_addr);
+    dll_hashDestroy(*dllptr_addr);
+    //the nodes of mapped lists go away along with the mapping
+    if ((*dllptr_addr)->map != NULL) {
+        munmap((*dllptr_addr)->map, (*dllptr_addr)->map_length);
+        (*dllptr_addr)->map = NULL;
+        (*dllptr_addr)->size = 0;
+    }
+    //free the elements and the nodes (pooled ones along with their chunks)
+    dll_nodesClear(*dllptr_addr, free_data);
+    //free iterators, if there are any
+    dll_iteratorsFree(*dllptr_addr);
+    //free the node pool, if there is one
+    dll_poolDestroy((*dllptr_addr)->pool);
+    dll_syncDestroy(*dllptr_addr);
+    dll_dequeDestroy(*dllptr_addr);
+    free((*dllptr_addr)->unrolled);
+    //free the doubly linked list structure
+    free(*dllptr_addr);
+    *dllptr_addr = NULL;
+}
+
+/*
+ *  Allocates a new Iterator object
+ *  assigning it to the head of the list and then returning its id
+ *  A list holds at most 65536 iterators at a time, so iterators that are no
+ *  longer needed must be deleted (dll_iteratorDelete). Slots are reused, and
+ *  the ID of a deleted iterator is recognized as stale until its slot has
+ *  been reused 32768 times
+ *  Return values:
+ *      [*] On success, the ID of the Iterator is returned
+ *      [*] On failure or on empty list, -1 is returned (IDs of live iterators
+ *          are never negative)
+ */
+IteratorID dll_iteratorRequest(list_t list)
+{
+    // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorRequest - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_dequeUnsupported(list, "dll_iteratorRequest"))
+        return -1;
+    // provide iterator only if list isn't empty
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorRequest - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return -1;
+    }
+    if (list->iteratorsFree == -1) {
+        //no free slot left, double the slots
+        int capacity = list->iteratorsCapacity > 0 ?
+                2 * list->iteratorsCapacity : 4;
+        if (capacity > (1 << DLL_ITER_SLOT_BITS)) {
+            fprintf(stderr, "dll_iteratorRequest - Error: Too many iterators\n");
+            return -1;
+        }
+        void* tmp = realloc(list->iteratorsArray, capacity * sizeof(dlliterator));
+        if (tmp == NULL) {
+            perror("dll_iteratorRequest - Error: Cannot allocate iterator");
+            return -1;
+        }
+        list->iteratorsArray = tmp;
+        int slot;
+        for (slot = list->iteratorsCapacity; slot < capacity; slot++) {
+            (list->iteratorsArray[slot]).generation = 0;
+            (list->iteratorsArray[slot]).next_free = slot + 1 < capacity ?
+                    slot + 1 : -1;
+        }
+        list->iteratorsFree = list->iteratorsCapacity;
+        list->iteratorsCapacity = capacity;
+    }
+    int slot = list->iteratorsFree;
+    dlliterator* iterator = &(list->iteratorsArray[slot]);
+    list->iteratorsFree = iterator->next_free;
+    iterator->next_free = DLL_ITER_LIVE;
+    //concurrent lists read the count without the iterators mutex
+    __atomic_add_fetch(&list->iteratorsCount, 1, __ATOMIC_SEQ_CST);
+    // set Iterator to point to the head
+    iterator->node = NULL;
+    iterator->mapped = NULL;
+    iterator->unode = NULL;
+    if (list->map != NULL)
+        iterator->mapped = dll_mapNodeAt(list, 0);
+    else if (list->unrolled != NULL)
+        dll_iteratorPlace(list, iterator, list->unrolled->head, 0);
+    else
+        dll_iteratorMove(list, iterator, list->head);
+    return (iterator->generation << DLL_ITER_SLOT_BITS) | slot;
+}
+
+
+dlliterator* dll_iteratorSlot(list_t list, IteratorID iterID)
+{
+    DLL_STAT(list, iterator_lookups, 1);
+    int slot = iterID & ((1 << DLL_ITER_SLOT_BITS) - 1);
+    if (iterID < 0 || slot >= list->iteratorsCapacity)
+        return NULL;
+    dlliterator* iterator = &(list->iteratorsArray[slot]);
+    if (iterator->next_free != DLL_ITER_LIVE ||
+            iterator->generation != iterID >> DLL_ITER_SLOT_BITS)
+        return NULL;
+    return iterator;
+}
+
+
+void dll_iteratorRelease(list_t list, int slot)
+{
+    dlliterator* iterator = &(list->iteratorsArray[slot]);
+    __atomic_sub_fetch(&list->iteratorsCount, 1, __ATOMIC_SEQ_CST);
+    //a stale ID only matches again once the slot has been reused for
+    //DLL_ITER_MAX_GENERATION + 1 more iterators
+    iterator->generation = (iterator->generation + 1) & DLL_ITER_MAX_GENERATION;
+    iterator->next_free = list->iteratorsFree;
+    list->iteratorsFree = slot;
+}
+
+
+void dll_iteratorMove(list_t list, dlliterator* iterator, dllnodeptr node)
+{
+    if (iterator->node != NULL)
+        dll_iteratorDetach(list, iterator);
+    int slot = iterator - list->iteratorsArray;
+    iterator->node = node;
+    iterator->previous_on_node = -1;
+    iterator->next_on_node = node->iterators;
+    if (node->iterators != -1)
+        (list->iteratorsArray[node->iterators]).previous_on_node = slot;
+    node->iterators = slot;
+}
+
+
+void dll_iteratorPlace(list_t list, dlliterator* iterator, dllunodeptr node,
+        int offset)
+{
+    iterator->offset = offset;
+    if (iterator->unode == node)
+        return;
+    if (iterator->unode != NULL)
+        dll_iteratorDetach(list, iterator);
+    int slot = iterator - list->iteratorsArray;
+    iterator->unode = node;
+    iterator->previous_on_node = -1;
+    iterator->next_on_node = node->iterators;
+    if (node->iterators != -1)
+        (list->iteratorsArray[node->iterators]).previous_on_node = slot;
+    node->iterators = slot;
+}
+
+
+void dll_iteratorDetach(list_t list, dlliterator* iterator)
+{
+    //mapped nodes never change, so their iterators are not tracked
+    if (list->map != NULL) {
+        iterator->mapped = NULL;
+        return;
+    }
+    int* first = (list->unrolled != NULL) ? &iterator->unode->iterators
+                                          : &iterator->node->iterators;
+    if (iterator->previous_on_node == -1)
+        *first = iterator->next_on_node;
+    else
+        (list->iteratorsArray[iterator->previous_on_node]).next_on_node =
+                iterator->next_on_node;
+    if (iterator->next_on_node != -1)
+        (list->iteratorsArray[iterator->next_on_node]).previous_on_node =
+                iterator->previous_on_node;
+    iterator->node = NULL;
+    iterator->unode = NULL;
+}
+
+
+void dll_iteratorsFree(list_t list)
+{
+    free(list->iteratorsArray);
+    list->iteratorsArray = NULL;
+    __atomic_store_n(&list->iteratorsCount, 0, __ATOMIC_SEQ_CST);
+    list->iteratorsCapacity = 0;
+    list->iteratorsFree = -1;
+}
+
+
+void dll_iteratorsMigrate(list_t alist, dllnodeptr node, list_t blist)
+{
+    if (__atomic_load_n(&alist->iteratorsCount, __ATOMIC_SEQ_CST) == 0)
+        return;
+    //the node keeps its list of iterators, which is made of the same slots in
+    //`list b`
+    int slot;
+    for (slot = node->iterators; slot != -1;
+            slot = (blist->iteratorsArray[slot]).next_on_node) {
+        blist->iteratorsArray[slot] = alist->iteratorsArray[slot];
+        __atomic_add_fetch(&blist->iteratorsCount, 1, __ATOMIC_SEQ_CST);
+        dll_iteratorRelease(alist, slot);
+    }
+}
+
+
+void dll_iteratorsAttach(list_t list, int first, int last, dllnodeptr node)
+{
+    dlliterator* iterators = list->iteratorsArray;
+    int slot;
+    for (slot = first; slot != -1; slot = iterators[slot].next_on_node)
+        iterators[slot].node = node;
+    iterators[first].previous_on_node = -1;
+    iterators[last].next_on_node = node->iterators;
+    if (node->iterators != -1)
+        iterators[node->iterators].previous_on_node = last;
+    node->iterators = first;
+}
+
+ /*
+  * Takes two nodes (dllnodeptr) acting as old and new
+  * finding all the iterators that point to old and updating them to point
+  * to the new node
+  * If the list is empty, it will delete all iterators
+  * Note: Will not used by the user
+  */
+ void dll_iteratorUpdate(list_t list, dllnodeptr old, dllnodeptr new)
+ {
+    if (__atomic_load_n(&list->iteratorsCount, __ATOMIC_SEQ_CST) == 0)
+        return;
+    if (dll_isempty(list))
+        dll_iteratorDeleteAll(list);
+    else if (old->iterators != -1) {
+        //only the iterators of the old node are visited, and their list is
+        //spliced in front of the one of the new node
+        dlliterator* iterators = list->iteratorsArray;
+        int slot, last = -1;
+        for (slot = old->iterators; slot != -1;
+                slot = iterators[slot].next_on_node) {
+            iterators[slot].node = new;
+            last = slot;
+        }
+        iterators[last].next_on_node = new->iterators;
+        if (new->iterators != -1)
+            iterators[new->iterators].previous_on_node = last;
+        new->iterators = old->iterators;
+        old->iterators = -1;
+    }
+ }
+
+
+/*
+ *  Sets the iterator with ID iterID
+ *  to point to the head of the list
+ *  Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ *      [*] On empty list, 1 is returned to indicate invalidation of iterators
+ */
+int dll_iteratorBegin(list_t list, IteratorID iterID)
+{
+    // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorBegin - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    // provide iterator only if list isn't empty
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorBegin - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return 1;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorBegin - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return -1;
+    }
+    if (list->map != NULL)
+        iterator->mapped = dll_mapNodeAt(list, 0);
+    else if (list->unrolled != NULL)
+        dll_iteratorPlace(list, iterator, list->unrolled->head, 0);
+    else
+        dll_iteratorMove(list, iterator, list->head);
+    return 0;
+}
+
+/*
+ *  Sets the iterator with ID iterID
+ *  to point to the tail of the list
+ *  Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ *      [*] On empty list, 1 is returned to indicate invalidation of iterators
+ */
+int dll_iteratorEnd(list_t list, IteratorID iterID)
+{
+    // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorEnd - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    // provide iterator only if list isn't empty
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorEnd - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return 1;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorEnd - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return -1;
+    }
+    if (list->map != NULL)
+        iterator->mapped = dll_mapNodeAt(list, list->size - 1);
+    else if (list->unrolled != NULL)
+        dll_iteratorPlace(list, iterator, list->unrolled->tail,
+                list->unrolled->tail->count - 1);
+    else
+        dll_iteratorMove(list, iterator, list->tail);
+    return 0;
+}
+
+/*
+ *  Returns the object of the node that is pointed by the iterator
+ *  Return values:
+ *      [*] On success, the object is returned
+ *      [*] On failure, NULL is returned
+ */
+ void* dll_iteratorGetObj(list_t list, IteratorID iterID)
+ {
+     // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorGetObj - Error: DLList has not been initialized\n");
+        return NULL;
+    }
+    // provide iterator only if list isn't empty
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorGetObj - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return NULL;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorGetObj - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return NULL;
+    }
+    if (list->map != NULL)
+        return iterator->mapped->payload;
+    if (list->unrolled != NULL)
+        return iterator->unode->items[iterator->offset];
+    return iterator->node->data;
+ }
+
+/*
+ *  Sets the iterator to the next node
+ *  If by advancing, the iterator is requested to point after the tail
+ *  of the list, 2 is returned
+ *  Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ *      [*] On empty list, 1 is returned to indicate invalidation of iterators
+ *      [*] On the case described above, 2 is returned
+ */
+ int dll_iteratorNext(list_t list, IteratorID iterID)
+ {
+     // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorNext - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    // provide iterator only if list isn't empty
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorNext - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return 1;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorNext - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return -1;
+    }
+    if (list->map != NULL) {
+        dllmapnodeptr next = dll_mapNodeNext(list, iterator->mapped);
+        if (next == NULL)
+            return 2;
+        iterator->mapped = next;
+        return 0;
+    }
+    if (list->unrolled != NULL) {
+        dllunodeptr node = iterator->unode;
+        if (iterator->offset + 1 < node->count)
+            iterator->offset++;
+        else if (node->next != NULL)
+            dll_iteratorPlace(list, iterator, node->next, 0);
+        else
+            return 2;
+        return 0;
+    }
+    // check the case of calling this function on a iterator that points to the
+    // tail of the list
+    if (iterator->node == list->tail) {
+        return 2;
+    }
+    dll_iteratorMove(list, iterator, iterator->node->next);
+    return 0;
+ }
+
+ /*
+ *  Sets the iterator to the previous node
+ *  If by requesting the previous node, the iterator points before the head
+ *  of the list, 2 is returned
+ *  Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ *      [*] On empty list, 1 is returned to indicate invalidation of iterators
+ *      [*] On the case described above, 2 is returned
+ */
+ int dll_iteratorPrev(list_t list, IteratorID iterID)
+ {
+     // check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorRequest - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    // provide iterator only if list isn't empty
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorRequest - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return 1;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorPrev - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return -1;
+    }
+    if (list->map != NULL) {
+        dllmapnodeptr previous = dll_mapNodePrevious(list, iterator->mapped);
+        if (previous == NULL)
+            return 2;
+        iterator->mapped = previous;
+        return 0;
+    }
+    if (list->unrolled != NULL) {
+        dllunodeptr node = iterator->unode;
+        if (iterator->offset > 0)
+            iterator->offset--;
+        else if (node->previous != NULL)
+            dll_iteratorPlace(list, iterator, node->previous,
+                    node->previous->count - 1);
+        else
+            return 2;
+        return 0;
+    }
+    // check the case of calling this function on a iterator that points to the
+    // head of the list
+    if (iterator->node == list->head) {
+        return 2;
+    }
+    dll_iteratorMove(list, iterator, iterator->node->previous);
+    return 0;
+}
+
+/*
+ * Acts both as a copy constructor and copy function
+ * When you need copy constructor functionality, dest IteratorID must be
+ * NULL, and this function will allocate a new iterator setting it
+ * to point to the node that src Iterator points
+ * When you need simple copy functionality, the function will copy the
+ * address of the node that src Iterator points to the node of dest Iterator
+ * Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ *      [*] On empty list, 1 is returned to indicate the invalidation of the
+ *          iterators
+ *      [*] On iteratorIdxOutOfBounds error, 2 is returned
+ *
+ */
+int dll_iteratorCopy(list_t list, const IteratorID src, IteratorID *dest)
+{
+    // check if list is null or empty
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorCopy - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorCopy - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return 1;
+    }
+    // check if src iterator is valid
+    dlliterator* srcIterator = dll_iteratorSlot(list, src);
+    if (srcIterator == NULL) {
+        fprintf(stderr, "dll_iteratorCopy - Error: Source iterator doesn't exist\n");
+        return 2;
+    }
+    // check which functionality is needed
+    if (*dest == -1) {
+        // copy constructor functionality
+        *dest = dll_iteratorRequest(list);
+        if (*dest == -1) {
+            fprintf(stderr, "dll_iteratorCopy - Error: Could not allocate dest"
+            "iterator\n");
+            return -1;
+        }
+        // set dest iterator node to point to src iterator node
+        dlliterator* destIterator = dll_iteratorSlot(list, *dest);
+        if (list->map != NULL)
+            destIterator->mapped = srcIterator->mapped;
+        else if (list->unrolled != NULL)
+            dll_iteratorPlace(list, destIterator, srcIterator->unode,
+                    srcIterator->offset);
+        else
+            dll_iteratorMove(list, destIterator, srcIterator->node);
+        return 0;
+    }
+    else {
+        // simple copy functionality
+        // set dest iterator node to point to src iterator node
+        dlliterator* destIterator = dll_iteratorSlot(list, *dest);
+        if (destIterator == NULL) {
+            fprintf(stderr, "dll_iteratorCopy - Error: Destination iterator"
+                    " doesn't exist\n");
+            return -1;
+        }
+        if (list->map != NULL)
+            destIterator->mapped = srcIterator->mapped;
+        else if (list->unrolled != NULL)
+            dll_iteratorPlace(list, destIterator, srcIterator->unode,
+                    srcIterator->offset);
+        else
+            dll_iteratorMove(list, destIterator, srcIterator->node);
+        return 0;
+    }
+}
+
+ /*
+  * Deletes the current node pointed by the iterator
+  * After the deletion the iterator points to the next element of the list
+  * (towards the tail). If the element to be destroyed is the last element of the
+  * list, which means that the list will be empty, all the iterators are
+  * invalidated
+  * Return values:
+  *         [*] On success, 0 is returned
+  *         [*] On failure, -1 is returned
+  *         [*] On empty list, 1 is returned to indicate invalidation of
+  *             iterators
+  */
+int dll_iteratorDeleteCurrentNode(list_t list, IteratorID iterID,
+        void (*free_data)(void*))
+{
+    // check if list is null or empty
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (dll_mapReadOnly(list, "dll_iteratorDeleteCurrentNode"))
+        return -1;
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error: DLList is empty\n"
+                "\tDeleting all iterators now...\n");
+        // invalidate - delete all iterators
+        dll_iteratorDeleteAll(list);
+        return 1;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return -1;
+    }
+    if (list->unrolled != NULL) {
+        //the iterator moves on along with the others on the element
+        DLL_STAT(list, deletes_iterator, 1);
+        void* data = dll_unrolledRemove(list, iterator->unode,
+                iterator->offset);
+        if (free_data != NULL)
+            (*free_data)(data);
+        return (list->size == 0) ? 1 : 0;
+    }
+    //set current node
+    dllnodeptr current = iterator->node;
+    //set iterator to the next element (towards the end of the list)
+    int setIteratorToEnd = 0;
+    if (dll_iteratorNext(list, iterID) == 2) {
+        //current node is tail node, hence dll_iteratorNext returned 2
+        //Setting the iterator to the end of the list, must occur after
+        //the deletion
+        setIteratorToEnd = 1;
+    }
+    //other iterators on the node move on as with dll_delete
+    if (current != list->head || current != list->tail)
+        dll_iteratorUpdate(list, current,
+                current->next != NULL ? current->next : current->previous);
+    //implement delete
+    DLL_STAT(list, deletes_iterator, 1);
+    if (current == list->head) {
+            if (current != list->tail) {
+                //first node doesn't have previous
+                (current->next)->previous = NULL;
+                list->head = current->next;
+                list->size--;
+                dll_nodeDelete(list, current, free_data);
+                current = NULL;
+            }
+            else {
+                // one and only node left in list
+                list->head = NULL;
+                list->tail = NULL;
+                list->size--;
+                dll_nodeDelete(list, current, free_data);
+                current = NULL;
+                // all the elements of the list have been deleted,
+                // indicate empty list
+                dll_iteratorDeleteAll(list);
+                return 1;
+            }
+        }
+        else if (current == list->tail) {
+            list->tail = current->previous;
+            //last node doesn't have next
+            (current->previous)->next = NULL;
+            list->size--;
+            dll_nodeDelete(list, current, free_data);
+            current = NULL;
+            if (setIteratorToEnd) {
+                if (dll_iteratorEnd(list, iterID) < 0) {
+                    fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error:"
+                            "Could not set iterator to the end of the list\n");
+                    return -1;
+                }
+            }
+        }
+        else {
+            (current->previous)->next = current->next;
+            (current->next)->previous = current->previous;
+            list->size--;
+            dll_nodeDelete(list, current, free_data);
+            current = NULL;
+        }
+    return 0;
+}
+
+/*
+ *  Deletes the iterator pointed by iterID
+ *  and then invalidating the iterID
+ *  Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_iteratorDelete(list_t list, IteratorID iterID)
+{
+    // firstly check if list is null or empty
+     if (list == NULL) {
+        fprintf(stderr, "dll_iteratorDelete - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    if (list->size == 0) {
+        fprintf(stderr, "dll_iteratorDelete - Error: DLList is empty\n");
+        //in that case, no iterators should exist
+        dll_iteratorDeleteAll(list);
+        return -1;
+    }
+    // find iterator's slot
+    dlliterator* iterator = dll_iteratorSlot(list, iterID);
+    if (iterator == NULL) {
+        fprintf(stderr, "dll_iteratorDelete - Error: "
+                "Iterator with ID == %d wasn't found\n", iterID);
+        return -1;
+    }
+    //the slot goes back to the free list, with a new generation
+    dll_iteratorDetach(list, iterator);
+    dll_iteratorRelease(list, iterator - list->iteratorsArray);
+    iterID = -1;
+    return 0;
+}
+
+/*
+ *  Deletes all the iterators
+ *  Return values:
+ *      [*] On success, 0 is returned
+ *      [*] On failure, -1 is returned
+ */
+int dll_iteratorDeleteAll(list_t list)
+{
+    //firstly check if list is null
+    if (list == NULL) {
+        fprintf(stderr, "dll_iteratorDeleteAll - Error: DLList has not been initialized\n");
+        return -1;
+    }
+    //slots are kept (and their generations bumped), so that the IDs of the
+    //deleted iterators are still recognized as stale
+    //(the nodes of an empty list are gone, along with their iterator lists)
+    int slot;
+    for (slot = 0; list->iteratorsCount > 0 &&
+            slot < list->iteratorsCapacity; slot++)
+        if ((list->iteratorsArray[slot]).next_free == DLL_ITER_LIVE) {
+            if (list->size > 0)
+                dll_iteratorDetach(list, &(list->iteratorsArray[slot]));
+            dll_iteratorRelease(list, slot);
+        }
+    return 0;
+}
+
+
+dllnodeptr dll_nodeAllocate(list_t list)
+{
+    dllnodeptr node;
+    if (list->pool == NULL)
+        node = malloc(list->node_size);
+    else
+        node = dll_poolAllocate(list->pool);
+    if (node == NULL)
+        return NULL;
+    node->tower = NULL;
+    node->iterators = -1;
+    if (list->sync != NULL)
+        pthread_mutex_init(dll_syncMutex(list, node, NULL), NULL);
+    return node;
+}
+
+
+dllnodeptr dll_nodeAllocateMany(list_t list, int count)
+{
+    dllpoolptr pool = list->pool;
+    if (pool->current == NULL || pool->current->capacity - pool->used < count) {
+        //give the rest of the current chunk to the free list and move on to
+        //a chunk that fits all the nodes
+        while (pool->current != NULL && pool->used < pool->current->capacity)
+            dll_poolRelease(pool, (char*) pool->current->nodes +
+                    pool->used++ * pool->node_size);
+        if (dll_poolGrow(pool, count > pool->chunk_nodes ? count
+                                                         : pool->chunk_nodes) == -1)
+            return NULL;
+    }
+    dllnodeptr first = (dllnodeptr) ((char*) pool->current->nodes +
+            pool->used * pool->node_size);
+    pool->used += count;
+    return first;
+}
+
+
+dllnodeptr dll_chainBuild(list_t list, void** items, int count,
+        void* (*duplicate)(void*), dllnodeptr* last)
+{
+    dllnodeptr block = NULL, first = NULL, previous = NULL, elem;
+    int i;
+    if (list->pool != NULL) {
+        block = dll_nodeAllocateMany(list, count);
+        if (block == NULL)
+            return NULL;
+    }
+    //allocate and link the nodes first, so that a failure has no elements
+    //to take care of
+    for (i = 0; i < count; i++) {
+        if (block != NULL)
+            elem = (dllnodeptr) ((char*) block + i * list->node_size);
+        else {
+            elem = dll_nodeAllocate(list);
+            if (elem == NULL) {
+                while (previous != NULL) {
+                    elem = previous;
+                    previous = previous->previous;
+                    dll_nodeRelease(list, elem);
+                }
+                return NULL;
+            }
+        }
+        elem->previous = previous;
+        elem->next = NULL;
+        elem->tower = NULL;
+        elem->iterators = -1;
+        if (previous == NULL)
+            first = elem;
+        else
+            previous->next = elem;
+        previous = elem;
+    }
+    for (i = 0, elem = first; i < count; i++, elem = elem->next)
+        dll_nodeSetData(list, elem, items[i], duplicate);
+    *last = previous;
+    return first;
+}
+
+
+void dll_nodeRelease(list_t list, dllnodeptr node)
+{
+    if (list->sync != NULL)
+        pthread_mutex_destroy(dll_syncMutex(list, node, NULL));
+    if (list->pool == NULL) {
+        free(node);
+        return;
+    }
+    dll_poolRelease(list->pool, node);
+}
+
+
+dllpoolptr dll_poolCreate(int chunk_nodes, size_t node_size)
+{
+    dllpoolptr pool = malloc(sizeof(struct DoublyLinkedListPool));
+    if (pool == NULL) {
+        perror("dll_poolCreate - Error allocating node pool");
+        return NULL;
+    }
+    pool->first = NULL;
+    pool->current = NULL;
+    pool->used = 0;
+    pool->chunk_nodes = chunk_nodes;
+    pool->node_size = node_size;
+    pool->free_list = NULL;
+    return pool;
+}
+
+
+int dll_poolGrow(dllpoolptr pool, int capacity)
+{
+    dllchunkptr chunk = malloc(sizeof(struct DoublyLinkedListPoolChunk) +
+            capacity * pool->node_size);
+    if (chunk == NULL)
+        return -1;
+    chunk->capacity = capacity;
+    if (pool->current == NULL) {
+        chunk->next = pool->first;
+        pool->first = chunk;
+    }
+    else {
+        chunk->next = pool->current->next;
+        pool->current->next = chunk;
+    }
+    pool->current = chunk;
+    pool->used = 0;
     return 0;
 }
 
 
-/*
- * Function responsible for inserting an element into the list while keeping it
- * sorted by a comparison defined by the user with a function called
- * issmaller(*). Elements are going to be inserted in ascending order starting
- * from the head.
- * The 4th argument (duplication function) is explained at the dll_insert_at_end
- * function.
- * Return values:
- *      [*] On success,  0 is returned
- *      [*] On failure,  -1 is returned
- *
- * (*): issmaller must be a function that:
- *      [*] Returns 1, if (1st parameter < 2nd parameter)
- *      [*] Returns 0, if (1st parameter >= 2nd parameter)
- */
-int dll_insert_sorted(list_t list, void* data,
-        int (*issmaller)(void*, void*), void* (*duplicate)(void*))
+void* dll_poolAllocate(dllpoolptr pool)
 {
-    /*
-     * Scenarios:
-     *      1. list is empty:
-     *              a. head and tail pointers point to the new node
-     *              b. next and previous pointers point to the node itself
-     *      2. list isn't empty:
-     *              find where in the list the element belongs (cases: )
-     *                  i. element is to be inserted at the end (bigger than
-     */
-    // Safety checks firstly
-    // 1. Dllist must be initialized
-    if (list == NULL) {
-        fprintf(stderr, "dll_insert_sorted - Error: DLList has not been initialized\n");
+    //recycle released nodes first
+    if (pool->free_list != NULL) {
+        void* storage = pool->free_list;
+        memcpy(&pool->free_list, storage, sizeof(void*));
+        return storage;
+    }
+    if (pool->current == NULL || pool->used == pool->current->capacity) {
+        //current chunk is exhausted, move on to a new one
+        if (dll_poolGrow(pool, pool->chunk_nodes) == -1)
+            return NULL;
+    }
+    return (char*) pool->current->nodes + pool->used++ * pool->node_size;
+}
+
+
+void dll_poolRelease(dllpoolptr pool, void* storage)
+{
+    memcpy(storage, &pool->free_list, sizeof(void*));
+    pool->free_list = storage;
+}
+
+
+void dll_poolDestroy(dllpoolptr pool)
+{
+    if (pool == NULL)
+        return;
+    dll_poolReset(pool);
+    free(pool);
+}
+
+
+void dll_poolReset(dllpoolptr pool)
+{
+    if (pool == NULL)
+        return;
+    dllchunkptr chunk = pool->first;
+    while (chunk != NULL) {
+        dllchunkptr next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    pool->first = NULL;
+    pool->current = NULL;
+    pool->used = 0;
+    pool->free_list = NULL;
+}
+
+
+void dll_arenaFree(list_t list)
+{
+    dllblockptr block = list->arena;
+    while (block != NULL) {
+        dllblockptr next = block->next;
+        free(block);
+        block = next;
+    }
+    list->arena = NULL;
+}
+
+
+void dll_arenaAdopt(list_t alist, list_t blist)
+{
+    if (blist->arena == NULL)
+        return;
+    dllblockptr last = blist->arena;
+    while (last->next != NULL)
+        last = last->next;
+    if (alist->arena == NULL)
+        alist->arena = blist->arena;
+    else {
+        last->next = alist->arena->next;
+        alist->arena->next = blist->arena;
+    }
+    blist->arena = NULL;
+}
+
+
+void dll_nodesClear(list_t list, void (*free_data)(void*))
+{
+    if (list->deque != NULL) {
+        dll_dequeDrain(list, free_data);
+        return;
+    }
+    if (list->unrolled != NULL) {
+        //the nodes go away along with the chunks of the pool
+        dllunodeptr node;
+        int offset;
+        for (node = list->unrolled->head; free_data != NULL && node != NULL;
+                node = node->next)
+            for (offset = 0; offset < node->count; offset++)
+                (*free_data)(node->items[offset]);
+        list->unrolled->head = NULL;
+        list->unrolled->tail = NULL;
+    }
+    //pooled nodes go away along with their chunks, so they are only visited
+    //when their elements need freeing
+    if (list->pool == NULL || (list->elem_size == 0 && free_data != NULL)) {
+        dllnodeptr current = list->head;
+        while (current != NULL) {
+            dllnodeptr next = current->next;
+            dll_nodeFreeData(list, current, free_data);
+            if (list->pool == NULL)
+                dll_nodeRelease(list, current);
+            current = next;
+        }
+    }
+    dll_poolReset(list->pool);
+    dll_arenaFree(list);
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->finger = NULL;
+}
+
+
+int dll_nodesAdopt(list_t alist, list_t blist)
+{
+    if (alist->elem_size != blist->elem_size) {
+        fprintf(stderr, "dll_nodesAdopt - Error: Lists hold elements of "
+                "different kind\n");
         return -1;
     }
-    // 2. Data must not be NULL
-    if (data == NULL) {
-        fprintf(stderr, "dll_insert_sorted - Error: Data given is NULL\n");
+    if ((alist->sync == NULL) != (blist->sync == NULL)) {
+        fprintf(stderr, "dll_nodesAdopt - Error: Cannot mix concurrent and "
+                "plain lists\n");
         return -1;
     }
-    if (dll_isempty(list))  {
-        dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
+    if ((alist->unrolled == NULL) != (blist->unrolled == NULL)) {
+        fprintf(stderr, "dll_nodesAdopt - Error: Cannot mix unrolled and "
+                "plain lists\n");
+        return -1;
+    }
+    if (alist->unrolled != NULL &&
+            alist->unrolled->node_elems != blist->unrolled->node_elems)
+        return dll_unrolledRepack(alist, blist);
+    //storage schemes that differ need the nodes of `list b` relocated,
+    //allocating all the new nodes first, so that a failure leaves b intact
+    int relocate = ((alist->pool == NULL) != (blist->pool == NULL));
+    dllnodeptr spare = NULL, current;
+    int i;
+    for (i = 0; relocate && i < blist->size; i++) {
+        dllnodeptr elem = dll_nodeAllocate(alist);
         if (elem == NULL) {
-            perror("dll_insert_sorted: Empty Dllist case, error: ");
+            perror("dll_nodesAdopt - Error: ");
+            while (spare != NULL) {
+                elem = spare;
+                spare = spare->next;
+                dll_nodeRelease(alist, elem);
+            }
             return -1;
         }
-        list->head = elem;
-        list->tail = elem;
-        list->size++;
-        elem->next = NULL;
-        elem->previous = NULL;
-        elem->data = (*duplicate)(data);
+        elem->next = spare;
+        spare = elem;
+    }
+    //the nodes carry the iterators of `list b`, which do not move along, and
+    //the towers and hash slots of its own indexes
+    dll_iteratorDeleteAll(blist);
+    dll_indexDestroy(blist);
+    dll_hashDestroy(blist);
+    //elements that live in the arena of `list b` stay where they are, so its
+    //blocks are handed over as well
+    if (alist->pool == NULL && blist->pool == NULL) {
+        dll_arenaAdopt(alist, blist);
         return 0;
     }
-    else {
-        //find where the new element is bigger than the tail
-        //so as to avoid the search method
-        if ( (*issmaller)((list->tail)->data, data) ) {
-            //case in which the element is to be added into the end of the list
-            dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-            if (elem == NULL) {
-                perror("dll_insert_sorted: Tail insertion case, error: ");
-                return -1;
+    if (alist->pool != NULL && blist->pool != NULL) {
+        //hand the chunks of `list b` over, in front of the chunks of `list a`
+        //(the unused space of these chunks is only reclaimed on destroy).
+        //Unrolled nodes of the same capacity are handed over the same way
+        dllpoolptr bpool = blist->pool;
+        if (bpool->first != NULL) {
+            dllchunkptr last = bpool->first;
+            while (last->next != NULL)
+                last = last->next;
+            last->next = alist->pool->first;
+            alist->pool->first = bpool->first;
+            if (alist->pool->current == NULL) {
+                alist->pool->current = last;
+                alist->pool->used = last->capacity;
             }
-            (list->tail)->next = elem;
-            elem->previous = list->tail;
-            elem->next = NULL;
-            list->tail = elem;
-            list->size++;
-            elem->data = (*duplicate)(data);
-            return 0;
         }
-        //search method
-        dllnodeptr current = list->head;
-        do {
-            if ( (*issmaller)(data, current->data) )
-                break;
-            else {
-                if (current == list->tail)
-                    break;
-                else
-                    current = current->next;
-            }
-        }while(1);
-        //here we must identify which break occurred
-        if (current == list->head) {
-            //case in which the element is to be added into the start of the list
-            dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
+        bpool->first = NULL;
+        bpool->current = NULL;
+        dll_poolDestroy(bpool);
+        blist->pool = NULL;
+        dll_arenaAdopt(alist, blist);
+        return 0;
+    }
+    //storage schemes differ, relocate the nodes of `list b` one by one
+    dllnodeptr previous = NULL;
+    current = blist->head;
+    while (current != NULL) {
+        dllnodeptr elem = spare;
+        spare = spare->next;
+        memcpy(elem, current, alist->node_size);
+        if (alist->elem_size > 0)
+            elem->data = elem->payload;
+        elem->previous = previous;
+        if (previous == NULL)
+            blist->head = elem;
+        else
+            previous->next = elem;
+        if (current == blist->tail)
+            blist->tail = elem;
+        previous = elem;
+        dllnodeptr next = current->next;
+        dll_nodeRelease(blist, current);
+        current = next;
+    }
+    dll_poolDestroy(blist->pool);
+    blist->pool = NULL;
+    dll_arenaAdopt(alist, blist);
+    return 0;
+}
+
+int dll_nodesMove(list_t alist, dllnodeptr first, dllnodeptr last, int count,
+        list_t blist, dllnodeptr before, int migrate)
+{
+    dllnodeptr spare = NULL, current;
+    int i;
+    //pooled nodes belong to the chunks of their list, so they are relocated,
+    //allocating all the new nodes first so that a failure leaves both intact
+    int relocate = (alist->pool != NULL || blist->pool != NULL);
+    if (relocate)
+        for (i = 0; i < count; i++) {
+            dllnodeptr elem = dll_nodeAllocate(blist);
             if (elem == NULL) {
-                perror("dll_insert_sorted: Tail insertion case, error: ");
+                perror("dll_nodesMove - Error: ");
+                while (spare != NULL) {
+                    elem = spare;
+                    spare = spare->next;
+                    dll_nodeRelease(blist, elem);
+                }
                 return -1;
             }
-            elem->next = list->head;
-            elem->previous = NULL;
-            (elem->next)->previous = elem;
-            list->head = elem;
-            list->size++;
-            elem->data = (*duplicate)(data);
-            return 0;
+            elem->next = spare;
+            spare = elem;
         }
-        else {
-            //add the element before the current node
-            dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-            if (elem == NULL) {
-                perror("dll_insert_sorted - Error: ");
-                return -1;
+    dllnodeptr previous = first->previous, next = last->next;
+    //iterators and the finger of `list a` move on as on a delete
+    dllnodeptr target = (next != NULL) ? next : previous;
+    if (migrate)
+        dll_iteratorsMigrate(alist, first, blist);
+    else if (target == NULL)
+        dll_iteratorDeleteAll(alist);
+    //a big range is cheaper to take out of the skip index by rebuilding it
+    int rebuild = (alist->index != NULL && 2 * count > alist->size);
+    if (rebuild)
+        dll_indexDestroy(alist);
+    if (alist->index != NULL || alist->hash != NULL || alist->finger != NULL ||
+            (alist->iteratorsCount > 0 && (target != NULL || migrate)))
+        //backwards, so that the index always finds a tower close behind
+        for (current = last; ; current = current->previous) {
+            if (alist->finger == current)
+                alist->finger = target;
+            if (migrate) {
+                if (current != first)
+                    dll_iteratorsMigrate(alist, current, blist);
             }
-            (current->previous)->next = elem;
-            elem->previous = current->previous;
-            current->previous = elem;
-            elem->next = current;
-            list->size++;
-            elem->data = (*duplicate)(data);
-            return 0;
+            else if (target != NULL)
+                dll_iteratorUpdate(alist, current, target);
+            if (alist->index != NULL)
+                dll_indexUnlink(alist, current);
+            if (alist->hash != NULL)
+                dll_hashRemove(alist, current);
+            if (current == first)
+                break;
+        }
+    if (previous == NULL)
+        alist->head = next;
+    else
+        previous->next = next;
+    if (next == NULL)
+        alist->tail = previous;
+    else
+        next->previous = previous;
+    alist->size -= count;
+    if (rebuild)
+        dll_indexEnable(alist);
+    if (relocate) {
+        dllnodeptr old = first;
+        previous = NULL;
+        for (i = 0; i < count; i++) {
+            dllnodeptr elem = spare;
+            spare = spare->next;
+            memcpy(elem, old, blist->node_size);
+            if (blist->elem_size > 0)
+                elem->data = elem->payload;
+            //migrated iterators follow their node
+            int slot;
+            for (slot = elem->iterators; slot != -1;
+                    slot = (blist->iteratorsArray[slot]).next_on_node)
+                (blist->iteratorsArray[slot]).node = elem;
+            elem->previous = previous;
+            if (previous == NULL)
+                first = elem;
+            else
+                previous->next = elem;
+            previous = elem;
+            next = old->next;
+            dll_nodeRelease(alist, old);
+            old = next;
+        }
+        last = previous;
+    }
+    //link the range in front of `before`
+    previous = (before != NULL) ? before->previous : blist->tail;
+    first->previous = previous;
+    last->next = before;
+    if (previous == NULL)
+        blist->head = first;
+    else
+        previous->next = first;
+    if (before == NULL)
+        blist->tail = last;
+    else
+        before->previous = last;
+    blist->size += count;
+    DLL_STAT_PEAK(blist);
+    dll_nodesIndex(blist, first, last);
+    return 0;
+}
+
+
+int dll_initWith(list_t *listptr_addr, size_t elem_size, int chunk_nodes)
+{
+    (*listptr_addr) = malloc(sizeof(struct DoublyLinkedList_ADT));
+    if ((*listptr_addr) == NULL) {
+        perror("dll_init - Error initializing DoublyLinkedList ADT");
+        return -1;
+    }
+    if (rwl_init(&((*listptr_addr)->lock)) == -1)
+    {
+        free(*listptr_addr);
+        *listptr_addr = NULL;
+        return -1;
+    }
+    (*listptr_addr)->head = NULL;
+    (*listptr_addr)->tail = NULL;
+    (*listptr_addr)->size = 0;
+    (*listptr_addr)->iteratorsArray = NULL;
+    (*listptr_addr)->iteratorsCount = 0;
+    (*listptr_addr)->iteratorsCapacity = 0;
+    (*listptr_addr)->iteratorsFree = -1;
+    (*listptr_addr)->elem_size = elem_size;
+    // keep pooled nodes pointer-aligned
+    (*listptr_addr)->node_size = (sizeof(struct DoublyLinkedListNode) +
+            elem_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    (*listptr_addr)->pool = NULL;
+    (*listptr_addr)->arena = NULL;
+    (*listptr_addr)->arena_block = 0;
+    (*listptr_addr)->index = NULL;
+    (*listptr_addr)->hash = NULL;
+    (*listptr_addr)->use_finger = 0;
+    (*listptr_addr)->finger = NULL;
+    (*listptr_addr)->sync = NULL;
+    (*listptr_addr)->unrolled = NULL;
+    (*listptr_addr)->deque = NULL;
+    (*listptr_addr)->map = NULL;
+    (*listptr_addr)->map_length = 0;
+#ifdef DLL_STATS
+    memset(&(*listptr_addr)->stats, 0, sizeof(struct dll_stats));
+#endif
+    if (chunk_nodes > 0) {
+        (*listptr_addr)->pool = dll_poolCreate(chunk_nodes,
+                (*listptr_addr)->node_size);
+        if ((*listptr_addr)->pool == NULL) {
+            free(*listptr_addr);
+            *listptr_addr = NULL;
+            return -1;
         }
     }
+    return 0;
+}
+
+
+void dll_nodeSetData(list_t list, dllnodeptr node, void* data,
+        void* (*duplicate)(void*))
+{
+    if (list->elem_size > 0) {
+        memcpy(node->payload, data, list->elem_size);
+        node->data = node->payload;
+    }
+    else
+        node->data = dll_dataDuplicate(list, data, duplicate);
+}
+
+
+void* dll_dataDuplicate(list_t list, void* data, void* (*duplicate)(void*))
+{
+    if (duplicate == &dll_dataAdopt)
+        return data;
+    DLL_STAT(list, duplicates, 1);
+    return (*duplicate)(data);
+}
+
+
+void* dll_dataAdopt(void* data)
+{
+    return data;
+}
+
+
+int dll_duplicateMissing(list_t list, void* (*duplicate)(void*),
+        const char* function)
+{
+    if (duplicate != NULL || list->elem_size > 0)
+        return 0;
+    fprintf(stderr, "%s - Error: Duplicate function is NULL\n", function);
+    return 1;
+}
+
+
+void dll_nodeDelete(list_t list, dllnodeptr node, void (*free_data)(void*))
+{
+    //the finger moves on to a neighbour (the node still points to them)
+    if (list->finger == node)
+        list->finger = node->next != NULL ? node->next : node->previous;
+    if (list->index != NULL)
+        dll_indexUnlink(list, node);
+    if (list->hash != NULL)
+        dll_hashRemove(list, node);
+    dll_nodeFreeData(list, node, free_data);
+    dll_nodeRelease(list, node);
+}
+
+
+void dll_nodeFreeData(list_t list, dllnodeptr node, void (*free_data)(void*))
+{
+    if (list->elem_size == 0 && free_data != NULL)
+        (*free_data)(node->data);
+}
+
+
+dllmapnodeptr dll_mapNodeAt(list_t list, int position)
+{
+    return (dllmapnodeptr) (list->map + sizeof(dllmapheader) +
+            (size_t) position * list->node_size);
+}
+
+
+dllmapnodeptr dll_mapNodeNext(list_t list, dllmapnodeptr node)
+{
+    return node->next == 0 ? NULL : (dllmapnodeptr) (list->map + node->next);
+}
+
+
+dllmapnodeptr dll_mapNodePrevious(list_t list, dllmapnodeptr node)
+{
+    return node->previous == 0 ? NULL :
+            (dllmapnodeptr) (list->map + node->previous);
+}
+
+
+int dll_mapReadOnly(list_t list, const char* function)
+{
+    if (list == NULL || list->map == NULL)
+        return 0;
+    fprintf(stderr, "%s - Error: Mapped lists are read-only\n", function);
+    return 1;
 }
 
 
-/*
- * Inserts the element `data` before the `key` element provided. If the key is
- * not found -1 is returned.
- * Return values:
- *      [*]: On success, 0 is returned
- *      [*]: On error or `on key not found`, -1 is returned
- */
-int dll_insert_before(list_t list, void* data, void* (*duplicate)(void*),
-        void* key, int (*is_equal)(void*, void*))
+size_t dll_mapNodeSize(size_t elem_size)
 {
-    // Safety checks firstly
-    // 1. Dllist must be initialized
-    if (list == NULL) {
-        fprintf(stderr, "dll_insert_before - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // 2. Data must not be NULL
-    if (data == NULL) {
-        fprintf(stderr, "dll_insert_before - Error: Data given is NULL\n");
-        return -1;
-    }
-    // 3. Key must not be NULL
-    if (key == NULL) {
-        fprintf(stderr, "dll_insert_before - Error: Key given is NULL\n");
-        return -1;
-    }
-    //find the element (if it exits)
-    dllnodeptr current = list->head;
-    do {
-        if ( (*is_equal)(key, current->data) ) {
-            //found correct place
-            //add the element before the current node
-            dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-            if (elem == NULL) {
-                perror("dll_insert_sorted - Error: ");
-                return -1;
-            }
-            elem->previous = current->previous;
-            elem->next = current;
-            if (current != list->head)
-                (current->previous)->next = elem;
-            else {
-                list->head = elem;
-                elem->previous = NULL;
-            }
-            current->previous = elem;
-            elem->data = (*duplicate)(data);
-            list->size++;
-            return 0;
-        }
-        else {
-            if (current == list->tail)
-                return -1;
-            else
-                current = current->next;
-        }
-    }while(1);
+    return sizeof(struct DoublyLinkedListMapNode) + ((elem_size + 7) & ~7);
 }
 
 
-/*
- * Inserts the element `data` after the `key` element provided. If the key is
- * not found -1 is returned.
- * Return values:
- *      [*]: On success, 0 is returned
- *      [*]: On error or `on key not found`, -1 is returned
- */
-int dll_insert_after(list_t list, void* data, void* (*duplicate)(void*),
-        void* key, int (*is_equal)(void*, void*)) {
-    // Safety checks firstly
-    // 1. Dllist must be initialized
-    if (list == NULL) {
-        fprintf(stderr, "dll_insert_before - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // 2. Data must not be NULL
-    if (data == NULL) {
-        fprintf(stderr, "dll_insert_before - Error: Data given is NULL\n");
-        return -1;
-    }
-    // 3. Key must not be NULL
-    if (key == NULL) {
-        fprintf(stderr, "dll_insert_before - Error: Key given is NULL\n");
-        return -1;
+dlltowerptr dll_towerCreate(dllnodeptr node, int height)
+{
+    dlltowerptr tower = malloc(sizeof(struct DoublyLinkedListTower) +
+            height * sizeof(tower->links[0]));
+    if (tower == NULL)
+        return NULL;
+    tower->node = node;
+    tower->height = height;
+    int level;
+    for (level = 0; level < height; level++) {
+        tower->links[level].previous = NULL;
+        tower->links[level].next = NULL;
+        tower->links[level].span = 0;
     }
-    //find the element (if it exits)
-    dllnodeptr current = list->head;
-    do {
-        if ( (*is_equal)(key, current->data) ) {
-            //found correct place
-            //add the element after the current node
-            dllnodeptr elem = malloc(sizeof(struct DoublyLinkedListNode));
-            if (elem == NULL) {
-                perror("dll_insert_sorted - Error: ");
+    return tower;
+}
+
+
+int dll_indexLink(list_t list, dllnodeptr first, dllnodeptr last)
+{
+    dllindexptr index = list->index;
+    if (index == NULL)
+        return 0;
+    dlltowerptr preds[DLL_INDEX_MAX_LEVEL];
+    int distance[DLL_INDEX_MAX_LEVEL];
+    dll_indexPreds(list, first->previous, preds, distance);
+    dllnodeptr current;
+    int level;
+    for (current = first; ; current = current->next) {
+        //every level is kept by a quarter of the nodes of the level below
+        int height = 0;
+        do {
+            index->seed ^= index->seed << 13;
+            index->seed ^= index->seed >> 17;
+            index->seed ^= index->seed << 5;
+            if ((index->seed & 3) != 0)
+                break;
+            height++;
+        } while (height < DLL_INDEX_MAX_LEVEL);
+        if (height > 0) {
+            current->tower = dll_towerCreate(current, height);
+            if (current->tower == NULL) {
+                perror("dll_indexLink - Error, dropping the index: ");
+                dll_indexDestroy(list);
                 return -1;
             }
-            elem->next = current->next;
-            elem->previous = current;
-            if (current != list->tail)
-                (current->next)->previous = elem;
-            else {
-                list->tail = elem;
-                elem->next = NULL;
-            }
-            current->next = elem;
-            elem->data = (*duplicate)(data);
-            list->size++;
-            return 0;
         }
-        else {
-            if (current == list->tail)
-                return -1;
+        for (level = 0; level < DLL_INDEX_MAX_LEVEL; level++) {
+            if (level < height) {
+                //the new tower splits the link of its predecessor in two
+                dlltowerptr next = preds[level]->links[level].next;
+                current->tower->links[level].previous = preds[level];
+                current->tower->links[level].next = next;
+                current->tower->links[level].span =
+                        preds[level]->links[level].span + 1 - distance[level];
+                if (next != NULL)
+                    next->links[level].previous = current->tower;
+                preds[level]->links[level].next = current->tower;
+                preds[level]->links[level].span = distance[level];
+                preds[level] = current->tower;
+                distance[level] = 0;
+            }
             else
-                current = current->next;
+                preds[level]->links[level].span++;
+            distance[level]++;
         }
-    }while(1);
+        if (current == last)
+            break;
+    }
+    return 0;
 }
 
 
-/*
- * Function that enables accessing data at the list, identified by the 2nd
- * argument, with an is_equal type function as 3rd argument
- * Return values:
- *      [*] On success, the object is returned
- *      [*] On element not found or on error, NULL is returned
- */
-void* dll_edit_data(list_t list, void* data, int (*is_equal)(void*, void*))
+void dll_indexUnlink(list_t list, dllnodeptr node)
 {
-    if (list == NULL) {
-        fprintf(stderr, "dll_edit_data - Error: DLList has not been initialized\n");
-        return NULL;
+    dlltowerptr preds[DLL_INDEX_MAX_LEVEL];
+    int distance[DLL_INDEX_MAX_LEVEL];
+    dll_indexPreds(list, node->previous, preds, distance);
+    dlltowerptr tower = node->tower;
+    int level, height = (tower != NULL) ? tower->height : 0;
+    for (level = 0; level < DLL_INDEX_MAX_LEVEL; level++) {
+        if (level < height) {
+            //the predecessor takes over the link (and the span) of the tower
+            dlltowerptr next = tower->links[level].next;
+            preds[level]->links[level].next = next;
+            preds[level]->links[level].span += tower->links[level].span - 1;
+            if (next != NULL)
+                next->links[level].previous = preds[level];
+        }
+        else
+            preds[level]->links[level].span--;
     }
-    if(dll_isempty(list)) {
-        return NULL;
+    free(tower);
+    node->tower = NULL;
+}
+
+
+void dll_indexPreds(list_t list, dllnodeptr previous, dlltowerptr* preds,
+        int* distance)
+{
+    //walk back along the chain to the nearest tower and then climb up the
+    //levels through the towers on the left, adding up the spans crossed
+    int d = 1;
+    while (previous != NULL && previous->tower == NULL) {
+        previous = previous->previous;
+        d++;
     }
-    else {
-        //find the element (if it exits)
-        //search method
-        dllnodeptr current = list->head;
-        do {
-            if ( (*is_equal)(data, current->data) )
-                return current->data;
-            else {
-                if (current == list->tail)
-                    return NULL;
-                else
-                    current = current->next;
-            }
-        }while(1);
+    dlltowerptr tower = (previous != NULL) ? previous->tower
+                                           : list->index->header;
+    int level;
+    for (level = 0; level < DLL_INDEX_MAX_LEVEL; level++) {
+        while (tower->height <= level) {
+            int top = tower->height - 1;
+            tower = tower->links[top].previous;
+            d += tower->links[top].span;
+        }
+        preds[level] = tower;
+        distance[level] = d;
     }
 }
 
 
-/*
- * Function that returns a copy of the data located at the front (Head) of
- * the list, if getCopy option is true, or the actual data if the option is
- * set to 0 (false)
- */
-const void* dll_get_front(list_t list, void* (*duplicate)(void*),
-        int getCopy) {
-    // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_get_front - Error: DLList has not been initialized\n");
-        return NULL;
-    }
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_get_front - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return NULL;
+dllnodeptr dll_indexNodeAt(list_t list, int position)
+{
+    //ranks count from 1 (the head), the header being at rank 0
+    dlltowerptr tower = list->index->header;
+    int rank = 0, target = position + 1, level;
+    for (level = DLL_INDEX_MAX_LEVEL - 1; level >= 0; level--)
+        while (tower->links[level].next != NULL &&
+                rank + tower->links[level].span <= target) {
+            rank += tower->links[level].span;
+            tower = tower->links[level].next;
+        }
+    dllnodeptr node = tower->node;
+    if (node == NULL) {
+        node = list->head;
+        rank = 1;
     }
-    if (getCopy)
-        return (*duplicate)(list->head->data);
+    for (; rank < target; rank++)
+        node = node->next;
+    return node;
+}
+
+
+dllnodeptr dll_nodeAt(list_t list, int position)
+{
+    if (list->index != NULL)
+        return dll_indexNodeAt(list, position);
+    dllnodeptr node;
+    int i;
+    if (position < list->size / 2)
+        for (node = list->head, i = 0; i < position; i++)
+            node = node->next;
     else
-        return list->head->data;
+        for (node = list->tail, i = list->size - 1; i > position; i--)
+            node = node->previous;
+    return node;
 }
 
 
-/*
- * Function that returns a copy of the data located at the back (Tail) of
- * the list, if getCopy option is true, or the actual data if the option is
- * set to 0 (false)
- */
-const void* dll_get_back(list_t list, void* (*duplicate)(void*),
-        int getCopy) {
-    // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_get_back - Error: DLList has not been initialized\n");
-        return NULL;
+dllnodeptr dll_indexSeek(list_t list, void* data,
+        int (*issmaller)(void*, void*), int inclusive)
+{
+    dlltowerptr tower = list->index->header;
+    int level;
+    for (level = DLL_INDEX_MAX_LEVEL - 1; level >= 0; level--) {
+        dlltowerptr next = tower->links[level].next;
+        while (next != NULL) {
+            DLL_STAT(list, compares, 1);
+            if (inclusive ? (*issmaller)(data, next->node->data)
+                          : !(*issmaller)(next->node->data, data))
+                break;
+            DLL_STAT(list, search_visits, 1);
+            tower = next;
+            next = tower->links[level].next;
+        }
     }
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_get_back - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return NULL;
+    return tower->node;
+}
+
+
+void dll_indexDestroy(list_t list)
+{
+    if (list->index == NULL)
+        return;
+    dlltowerptr tower = list->index->header->links[0].next;
+    while (tower != NULL) {
+        dlltowerptr next = tower->links[0].next;
+        tower->node->tower = NULL;
+        free(tower);
+        tower = next;
     }
-    if (getCopy)
-        return (*duplicate)(list->tail->data);
-    else
-        return list->tail->data;
+    free(list->index->header);
+    free(list->index);
+    list->index = NULL;
 }
 
 
-/*
- * Function that is responsible for copying src list to dest list
- * Dest list must be initialized and empty
- * Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- *      [*] On destination list not empty, 2 is returned
- *      [*] On empty source list, 1 is returned
- */
-int dll_copy(list_t src, list_t dest, void* (*duplicate)(void*),
-        void (*free_data)(void*))
+int dll_nodesIndex(list_t list, dllnodeptr first, dllnodeptr last)
 {
-    // check if list is null
-    if (src == NULL) {
-        fprintf(stderr, "dll_copy - Error: Source list has not been initialized\n");
-        return -1;
+    int retval = 0;
+    if (list->index != NULL)
+        retval = dll_indexLink(list, first, last);
+    if (list->hash != NULL) {
+        dllnodeptr current;
+        for (current = first; ; current = current->next) {
+            if (dll_hashInsert(list, current) == -1)
+                return -1;
+            if (current == last)
+                break;
+        }
     }
-    // check if list is null
-    if (dest == NULL) {
-        fprintf(stderr, "dll_copy - Error: Destination list has not been "
-                "initialized\n");
-        return -1;
+    return retval;
+}
+
+
+dllnodeptr dll_nodeFind(list_t list, void* key, int (*is_equal)(void*, void*))
+{
+    DLL_STAT(list, searches, 1);
+    if (list->hash != NULL) {
+        dllhashptr hash = list->hash;
+        unsigned int hvalue = (*hash->hash)(key);
+        unsigned int slot = hvalue & (hash->capacity - 1);
+        while (hash->slots[slot].node != NULL) {
+            DLL_STAT(list, search_visits, 1);
+            if (hash->slots[slot].hash == hvalue) {
+                DLL_STAT(list, compares, 1);
+                if ( (*is_equal)(key, hash->slots[slot].node->data) )
+                    return hash->slots[slot].node;
+            }
+            slot = (slot + 1) & (hash->capacity - 1);
+        }
+        return NULL;
     }
-    if(!dll_isempty(dest)) {
-        fprintf(stderr, "dll_copy - Error: Destination list is not empty\n");
-        return 2;
+    if (list->use_finger) {
+        //look on both sides of the finger in turn, moving away from it, so
+        //that a key at distance d is found after 2d comparisons at most
+        dllnodeptr forward = list->finger, backward = NULL;
+        if (forward == NULL)
+            forward = list->head;
+        else
+            backward = forward->previous;
+        while (forward != NULL || backward != NULL) {
+            if (forward != NULL) {
+                DLL_STAT(list, search_visits, 1);
+                DLL_STAT(list, compares, 1);
+                if ( (*is_equal)(key, forward->data) )
+                    return list->finger = forward;
+                forward = forward->next;
+            }
+            if (backward != NULL) {
+                DLL_STAT(list, search_visits, 1);
+                DLL_STAT(list, compares, 1);
+                if ( (*is_equal)(key, backward->data) )
+                    return list->finger = backward;
+                backward = backward->previous;
+            }
+        }
+        return NULL;
     }
-    if(dll_isempty(src)) {
-        fprintf(stderr, "dll_copy - Notify: Source list is empty\n");
-        // nothing to do here
-        return 1;
+    dllnodeptr current = list->head;
+    while (current != NULL) {
+        DLL_STAT(list, search_visits, 1);
+        DLL_STAT(list, compares, 1);
+        if ( (*is_equal)(key, current->data) )
+            return current;
+        current = current->next;
     }
-    // iterate through source list
-    IteratorID srcIter = dll_iteratorRequest(src);
-    if (srcIter == -1) {
-        fprintf(stderr, "dll_copy - Error: Requesting iterator for the source "
-        "list failed\n");
+    return NULL;
+}
+
+
+int dll_hashInsert(list_t list, dllnodeptr node)
+{
+    dllhashptr hash = list->hash;
+    //keep the table at most half full
+    if (2 * (hash->count + 1) > hash->capacity &&
+            dll_hashResize(hash, 2 * hash->capacity) == -1) {
+        perror("dll_hashInsert - Error, dropping the hash index: ");
+        dll_hashDestroy(list);
         return -1;
     }
-    while (1) {
-        // insert data pointed
-        void* data = dll_iteratorGetObj(src, srcIter);
-        if (data == NULL) {
-            fprintf(stderr, "dll_copy - Error: Cannot access data from source"
-                    " list\nDestroying destination list completely\n");
-            dll_destroy(&dest, free_data);
-            return -1;
-        }
-        if (dll_insert_at_back(dest, data, duplicate) == -1) {
-            fprintf(stderr, "dll_copy - Error: Cannot insert data to "
-            " destination list\n"
-                    "Destroying destination list completely\n");
-            dll_destroy(&dest, free_data);
-            return -1;
-        }
-        int retval = dll_iteratorNext(src, srcIter);
-        if (retval == 2)
-            // reached end of the source list, end loop
-            break;
-        else if (retval == -1) {
-            fprintf(stderr, "dll_copy - Error: Cannot iterate through source "
-                    "list\nDestroying destination list completely\n");
-            dll_destroy(&dest, free_data);
-            return -1;
+    unsigned int hvalue = (*hash->hash)(node->data);
+    unsigned int slot = hvalue & (hash->capacity - 1);
+    while (hash->slots[slot].node != NULL)
+        slot = (slot + 1) & (hash->capacity - 1);
+    hash->slots[slot].node = node;
+    hash->slots[slot].hash = hvalue;
+    hash->count++;
+    return 0;
+}
+
+
+void dll_hashRemove(list_t list, dllnodeptr node)
+{
+    dllhashptr hash = list->hash;
+    unsigned int mask = hash->capacity - 1;
+    unsigned int slot = (*hash->hash)(node->data) & mask;
+    while (hash->slots[slot].node != node) {
+        if (hash->slots[slot].node == NULL)
+            return;
+        slot = (slot + 1) & mask;
+    }
+    //shift back the entries of the cluster that follows, so that no probe
+    //sequence gets broken by the empty slot
+    unsigned int empty = slot;
+    for (slot = (slot + 1) & mask; hash->slots[slot].node != NULL;
+            slot = (slot + 1) & mask) {
+        unsigned int home = hash->slots[slot].hash & mask;
+        if (((slot - home) & mask) >= ((slot - empty) & mask)) {
+            hash->slots[empty] = hash->slots[slot];
+            empty = slot;
         }
     }
+    hash->slots[empty].node = NULL;
+    hash->count--;
+}
+
+
+int dll_hashResize(dllhashptr hash, unsigned int capacity)
+{
+    dllhashslot *slots = calloc(capacity, sizeof(dllhashslot));
+    if (slots == NULL)
+        return -1;
+    unsigned int idx;
+    for (idx = 0; idx < hash->capacity; idx++) {
+        if (hash->slots[idx].node == NULL)
+            continue;
+        unsigned int slot = hash->slots[idx].hash & (capacity - 1);
+        while (slots[slot].node != NULL)
+            slot = (slot + 1) & (capacity - 1);
+        slots[slot] = hash->slots[idx];
+    }
+    free(hash->slots);
+    hash->slots = slots;
+    hash->capacity = capacity;
     return 0;
 }
 
 
-/*
- * Function responsible for appending `list b` to `list a`
- * Upon return, the second list is going to be freed
- * and nullified, so that it cannot longer be used
- */
-void dll_append(list_t alist, list_t* listptrb)
+void dll_hashDestroy(list_t list)
 {
-    //make the tail of `list a` to point to the `list b` head
-    (alist->tail)->next = (*listptrb)->head;
-    //symmetrically
-    ((*listptrb)->head)->previous = alist->tail;
-    //update `list a` tail
-    alist->tail = (*listptrb)->tail;
-    //update sizes
-    alist->size += (*listptrb)->size;
-    //free `list b`
-    (*listptrb)->head = NULL;
-    (*listptrb)->tail = NULL;
-    (*listptrb)->size = 0;
-    free(*listptrb);
-    listptrb = NULL;
+    if (list->hash == NULL)
+        return;
+    free(list->hash->slots);
+    free(list->hash);
+    list->hash = NULL;
 }
 
-/*
- * Function responsible for deleting the element that contains the `key`
- * given as a 2nd parameter
- * Also, two pointers to functions needed, the 1st for identifying the
- * correct element and the second one for freeing it
- * Return values:
- *      [*] On success,             0 is returned
- *      [*] On element not found,   1 is returned
- *      [*] On error,               -1 is returned
- */
-int dll_delete(list_t list, void* key, int (*is_equal)(void*, void*),
-                void (*free_data)(void*))
+
+dllnodeptr dll_chainMerge(dllnodeptr first, dllnodeptr second,
+        int (*issmaller)(void*, void*))
 {
-    if (list == NULL) {
-        fprintf(stderr, "dll_delete - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    if (key == NULL) {
-        fprintf(stderr, "dll_delete - Error: Key parameter is NULL\n");
-        return -1;
-    }
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_delete - Error: DLList is empty\n");
-        return 1;
-    }
-    else {
-        //find the element (if it exits and delete it)
-        //search method
-        dllnodeptr current = list->head;
-        do {
-            if ( (*is_equal)(key, current->data) )
-                break;
-            else {
-                if (current == list->tail)
-                {
-                    current = NULL;
-                    break;
-                }
-                else
-                    current = current->next;
-            }
-        }while(1);
-        if (current == NULL) {
-            //element wasn't found
-            return 1;
-        }
-        else if (current == list->head) {
-            if (current != list->tail) {
-                //first node doesn't have previous
-                list->size--;
-                dll_iteratorUpdate(list, current, current->next);
-                (current->next)->previous = NULL;
-                list->head = current->next;
-                (*free_data)((void*) current->data);
-                free(current);
-                current = NULL;
-            }
-            else {
-                //case in which we are deleting the one and only
-                //element of the list
-                list->head = NULL;
-                list->tail = NULL;
-                list->size--;
-                (*free_data)((void*) current->data);
-                free(current);
-                current = NULL;
-                dll_iteratorUpdate(list, NULL, NULL);
-            }
-        }
-        else if (current == list->tail) {
-            list->size--;
-            dll_iteratorUpdate(list, current, current->previous);
-            list->tail = current->previous;
-            //last node doesn't have next
-            (current->previous)->next = NULL;
-            (*free_data)((void*)current->data);
-            free(current);
-            current = NULL;
+    struct DoublyLinkedListNode dummy;
+    dllnodeptr last = &dummy;
+    while (first != NULL && second != NULL) {
+        //take from the 2nd chain only when strictly smaller, for stability
+        if ( (*issmaller)(second->data, first->data) ) {
+            last->next = second;
+            second = second->next;
         }
         else {
-            list->size--;
-            dll_iteratorUpdate(list, current, current->next);
-            (current->previous)->next = current->next;
-            (current->next)->previous = current->previous;
-            (*free_data)((void*)current->data);
-            free(current);
-            current = NULL;
+            last->next = first;
+            first = first->next;
         }
-        return 0;
+        last = last->next;
     }
+    last->next = (first != NULL) ? first : second;
+    return dummy.next;
 }
 
 
-/*
- * Deletes the tail element of the list
- */
-void dll_delete_back(list_t list, void (*free_data)(void* data))
+dllnodeptr dll_chainSort(dllnodeptr first, int (*issmaller)(void*, void*))
 {
-    list->size--;
-    dllnodeptr deletion = list->tail;
-    if (list->size > 0) {
-        //take care of iterators that point to tail, so as to point to the new tail
-        //element of the list
-        dll_iteratorUpdate(list, deletion, deletion->previous);
-        list->tail = (list->tail)->previous;
-        (list->tail)->next = NULL;
+    //bins[i] holds a sorted chain of 2^i nodes, older nodes in higher bins
+    dllnodeptr bins[DLL_SORT_BINS] = { NULL };
+    int bin, used = 0;
+    while (first != NULL) {
+        dllnodeptr carry = first;
+        first = first->next;
+        carry->next = NULL;
+        for (bin = 0; bin < used && bins[bin] != NULL; bin++) {
+            carry = dll_chainMerge(bins[bin], carry, issmaller);
+            bins[bin] = NULL;
+        }
+        bins[bin] = carry;
+        if (bin == used)
+            used++;
+    }
+    dllnodeptr result = NULL;
+    for (bin = 0; bin < used; bin++)
+        if (bins[bin] != NULL)
+            result = dll_chainMerge(bins[bin], result, issmaller);
+    return result;
+}
 
-        (*free_data)(deletion->data);
-        deletion->data = NULL;
-        deletion->previous = NULL;
-        free(deletion);
-        deletion = NULL;
+
+void dll_chainRelink(list_t list, dllnodeptr first)
+{
+    dllnodeptr previous = NULL, current;
+    for (current = first; current != NULL; current = current->next) {
+        current->previous = previous;
+        previous = current;
     }
-    else {
-        // list is empty
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        list->head = NULL;
-        list->tail = NULL;
-        (*free_data)(deletion->data);
-        deletion->data = NULL;
-        deletion->next = NULL;
-        free(deletion);
-        deletion = NULL;
+    list->head = first;
+    list->tail = previous;
+}
+
+
+void dll_runParallel(void* (*worker)(void*), void* args, size_t argsize,
+        int count)
+{
+    if (count <= 0)
+        return;
+    pthread_t* threads = malloc(count * sizeof(pthread_t));
+    int* started = calloc(count, sizeof(int));
+    int idx;
+    for (idx = 1; idx < count && threads != NULL && started != NULL; idx++)
+        started[idx] = (pthread_create(&threads[idx], NULL, worker,
+                (char*) args + idx * argsize) == 0);
+    (*worker)(args);
+    for (idx = 1; idx < count; idx++) {
+        if (started != NULL && started[idx])
+            pthread_join(threads[idx], NULL);
+        else
+            (*worker)((char*) args + idx * argsize);
     }
+    free(threads);
+    free(started);
 }
 
 
-/*
- * Deletes the head element of the list
- */
-void dll_delete_front(list_t list, void (*free_data)(void* data))
+int dll_ioFlush(dllio* io)
 {
-    list->size--;
-    dllnodeptr deletion = list->head;
-    if (list->size > 0) {
-        //take care of iterators that point to head, so as they point to the next
-        //element (new head) of the list
-        dll_iteratorUpdate(list, deletion, deletion->next);
-        list->head = (list->head)->next;
-        (list->head)->previous = NULL;
+    while (io->start < io->end) {
+        ssize_t written = write(io->fd, io->buffer + io->start,
+                io->end - io->start);
+        if (written == -1) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        io->start += written;
+    }
+    io->start = 0;
+    io->end = 0;
+    return 0;
+}
 
-        (*free_data)(deletion->data);
-        deletion->data = NULL;
-        deletion->next = NULL;
-        free(deletion);
-        deletion = NULL;
+
+char* dll_ioReserve(dllio* io, size_t size)
+{
+    if (io->capacity - io->end < size) {
+        if (dll_ioFlush(io) == -1)
+            return NULL;
+        if (io->capacity < size) {
+            char* buffer = realloc(io->buffer, size);
+            if (buffer == NULL)
+                return NULL;
+            io->buffer = buffer;
+            io->capacity = size;
+        }
     }
-    else {
-        // list is empty
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        list->head = NULL;
-        list->tail = NULL;
-        (*free_data)(deletion->data);
-        deletion->data = NULL;
-        deletion->next = NULL;
-        free(deletion);
-        deletion = NULL;
+    return io->buffer + io->end;
+}
+
+
+char* dll_ioTake(dllio* io, size_t size)
+{
+    if (io->end - io->start < size) {
+        //move the leftover to the front and fill the rest of the buffer
+        memmove(io->buffer, io->buffer + io->start, io->end - io->start);
+        io->end -= io->start;
+        io->start = 0;
+        if (io->capacity < size) {
+            char* buffer = realloc(io->buffer, size);
+            if (buffer == NULL)
+                return NULL;
+            io->buffer = buffer;
+            io->capacity = size;
+        }
+        while (io->end < size) {
+            ssize_t got = read(io->fd, io->buffer + io->end,
+                    io->capacity - io->end);
+            if (got == -1 && errno == EINTR)
+                continue;
+            if (got <= 0)
+                return NULL;
+            io->end += got;
+        }
     }
+    io->start += size;
+    return io->buffer + io->start - size;
 }
 
 
-/*
- * Function responsible for freeing all the allocated memory
- */
-void dll_destroy(list_t *dllptr_addr, void (*free_data)(void* data))
+int dll_syncCreate(list_t list)
 {
-    if (*dllptr_addr == NULL) {
-        fprintf(stderr, "dll_destroy - Error: DLList has not been initialized\n");
+    dllsyncptr sync = malloc(sizeof(struct DoublyLinkedListSync));
+    if (sync == NULL) {
+        perror("dll_syncCreate - Error: ");
+        return -1;
+    }
+    pthread_mutex_init(&sync->head, NULL);
+    pthread_mutex_init(&sync->tail, NULL);
+    pthread_mutex_init(&sync->iterators, NULL);
+    //the node mutex goes after the node, pointer-aligned like the node itself
+    sync->node_lock = list->node_size;
+    list->node_size = (list->node_size + sizeof(pthread_mutex_t) +
+            sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    list->sync = sync;
+    return 0;
+}
+
+
+void dll_syncDestroy(list_t list)
+{
+    if (list->sync == NULL)
         return;
+    pthread_mutex_destroy(&list->sync->head);
+    pthread_mutex_destroy(&list->sync->tail);
+    pthread_mutex_destroy(&list->sync->iterators);
+    free(list->sync);
+    list->sync = NULL;
+}
+
+
+pthread_mutex_t* dll_syncMutex(list_t list, dllnodeptr node,
+        pthread_mutex_t* end)
+{
+    if (node == NULL)
+        return end;
+    return (pthread_mutex_t*) ((char*) node + list->sync->node_lock);
+}
+
+
+dllnodeptr dll_syncSeek(list_t list, void* key, int (*stop)(void*, void*),
+        dllnodeptr* previous)
+{
+    dllsyncptr sync = list->sync;
+    dllnodeptr prev = NULL, current;
+    DLL_STAT(list, searches, 1);
+    DLL_LOCK(list, &sync->head);
+    current = list->head;
+    while (current != NULL) {
+        //hand over hand: lock the next node before letting go of the previous
+        DLL_LOCK(list, dll_syncMutex(list, current, NULL));
+        DLL_STAT(list, search_visits, 1);
+        DLL_STAT(list, compares, 1);
+        if ( (*stop)(key, current->data) )
+            break;
+        pthread_mutex_unlock(dll_syncMutex(list, prev, &sync->head));
+        prev = current;
+        current = current->next;
+    }
+    *previous = prev;
+    return current;
+}
+
+
+dllnodeptr dll_syncLockBack(list_t list)
+{
+    dllsyncptr sync = list->sync;
+    while (1) {
+        DLL_LOCK(list, &sync->tail);
+        dllnodeptr last = list->tail;
+        //the last node comes before the tail mutex in the locking order
+        if (last == NULL ||
+                DLL_TRYLOCK(list, dll_syncMutex(list, last, NULL)) == 0)
+            return last;
+        pthread_mutex_unlock(&sync->tail);
+        sched_yield();
     }
-    if(dll_isempty(*dllptr_addr)) {
-        //free iterators, if there are any
-        dll_iteratorDeleteAll(*dllptr_addr);
-        //free doubly linked list structure
-        free(*dllptr_addr);
-        *dllptr_addr = NULL;
+}
+
+
+void dll_syncLink(list_t list, dllnodeptr previous, dllnodeptr node,
+        dllnodeptr next)
+{
+    node->previous = previous;
+    node->next = next;
+    if (previous == NULL)
+        list->head = node;
+    else
+        previous->next = node;
+    if (next == NULL)
+        list->tail = node;
+    else
+        next->previous = node;
+    __atomic_add_fetch(&list->size, 1, __ATOMIC_RELAXED);
+    DLL_STAT_PEAK(list);
+}
+
+
+void dll_syncUnlink(list_t list, dllnodeptr node)
+{
+    if (node->previous == NULL)
+        list->head = node->next;
+    else
+        (node->previous)->next = node->next;
+    if (node->next == NULL)
+        list->tail = node->previous;
+    else
+        (node->next)->previous = node->previous;
+    __atomic_sub_fetch(&list->size, 1, __ATOMIC_RELAXED);
+    //iterators move on to a neighbour, which is locked as well. The count is
+    //kept atomically, so that without any iterator the mutex can be skipped
+    if (__atomic_load_n(&list->iteratorsCount, __ATOMIC_SEQ_CST) == 0)
         return;
+    DLL_LOCK(list, &list->sync->iterators);
+    dll_iteratorUpdate(list, node,
+            node->next != NULL ? node->next : node->previous);
+    pthread_mutex_unlock(&list->sync->iterators);
+}
+
+
+int dll_syncInsertBack(list_t list, void* data, void* (*duplicate)(void*))
+{
+    dllsyncptr sync = list->sync;
+    dllnodeptr elem = dll_nodeAllocate(list);
+    if (elem == NULL) {
+        perror("dll_insert_at_back - Error: ");
+        return -1;
     }
-    else {
-        dllnodeptr current = (*dllptr_addr)->head;
-        dllnodeptr to_be_deleted = NULL;
-        while(1) {
-            if (current == NULL)
-                break;
-            to_be_deleted = current;
-            //avoid dangling pointers
-            if (to_be_deleted == (*dllptr_addr)->head)
-                (*dllptr_addr)->head = NULL;
-            else if(to_be_deleted == (*dllptr_addr)->tail)
-                (*dllptr_addr)->tail = NULL;
-            current = current->next;
-            (*free_data)(to_be_deleted->data);
-            free(to_be_deleted);
-            to_be_deleted = NULL;
+    dll_nodeSetData(list, elem, data, duplicate);
+    rwl_readLock(list->lock);
+    while (1) {
+        dllnodeptr last = dll_syncLockBack(list);
+        if (last != NULL) {
+            dll_syncLink(list, last, elem, NULL);
+            pthread_mutex_unlock(dll_syncMutex(list, last, NULL));
+            pthread_mutex_unlock(&sync->tail);
+            break;
         }
-        (*dllptr_addr)->size = 0;
-        //free iterators, if there are any
-        dll_iteratorDeleteAll(*dllptr_addr);
-        //free the doubly linked list structure
-        free(*dllptr_addr);
-        *dllptr_addr = NULL;
-        return;
+        //empty list, both ends are needed (in order)
+        pthread_mutex_unlock(&sync->tail);
+        DLL_LOCK(list, &sync->head);
+        DLL_LOCK(list, &sync->tail);
+        int empty = (list->tail == NULL);
+        if (empty)
+            dll_syncLink(list, NULL, elem, NULL);
+        pthread_mutex_unlock(&sync->tail);
+        pthread_mutex_unlock(&sync->head);
+        if (empty)
+            break;
     }
+    rwl_readUnlock(list->lock);
+    return 0;
 }
 
-/*
- *  Allocates a new Iterator object
- *  assigning it to the head of the list and then returning its id
- *  Return values:
- *      [*] On success, the ID of the Iterator is returned
- *      [*] On failure, -1 is returned
- */
-IteratorID dll_iteratorRequest(list_t list)
+
+int dll_syncInsertFront(list_t list, void* data, void* (*duplicate)(void*))
 {
-    // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorRequest - Error: DLList has not been initialized\n");
+    dllsyncptr sync = list->sync;
+    dllnodeptr elem = dll_nodeAllocate(list);
+    if (elem == NULL) {
+        perror("dll_insert_at_front - Error: ");
         return -1;
     }
-    // provide iterator only if list isn't empty
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorRequest - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return 1;
-    }
-    void* tmp = realloc(list->iteratorsArray, (list->iteratorsCount + 1) * sizeof(dlliterator));
-    if (tmp == NULL) {
-        perror("dll_requestIterator - Error: Cannot allocate iterator");
+    dll_nodeSetData(list, elem, data, duplicate);
+    rwl_readLock(list->lock);
+    DLL_LOCK(list, &sync->head);
+    dllnodeptr first = list->head;
+    DLL_LOCK(list, dll_syncMutex(list, first, &sync->tail));
+    dll_syncLink(list, NULL, elem, first);
+    pthread_mutex_unlock(dll_syncMutex(list, first, &sync->tail));
+    pthread_mutex_unlock(&sync->head);
+    rwl_readUnlock(list->lock);
+    return 0;
+}
+
+
+int dll_syncInsertAt(list_t list, void* data, void* (*duplicate)(void*),
+        void* key, int (*stop)(void*, void*), int where)
+{
+    dllsyncptr sync = list->sync;
+    dllnodeptr elem = dll_nodeAllocate(list);
+    if (elem == NULL) {
+        perror("dll_insert - Error: ");
         return -1;
     }
-    else
-        list->iteratorsArray = tmp;
-    (list->iteratorsArray[list->iteratorsCount]).id = list->id_counter;
-    list->iteratorsCount++;
-    // set Iterator to point to the head
-    if (dll_iteratorBegin(list, list->id_counter) < 0) {
-        fprintf(stderr, "dll_requestIterator - Error: Cannot set iterator to list head\n");
-        return -1;
+    rwl_readLock(list->lock);
+    dllnodeptr previous, current = dll_syncSeek(list, key, stop, &previous);
+    int retval = 0;
+    //the data is duplicated only once the key has been found
+    if (current != NULL || where == DLL_SYNC_SORTED)
+        dll_nodeSetData(list, elem, data, duplicate);
+    if (current == NULL && where != DLL_SYNC_SORTED)
+        retval = -1;
+    else if (where == DLL_SYNC_AFTER) {
+        dllnodeptr next = current->next;
+        DLL_LOCK(list, dll_syncMutex(list, next, &sync->tail));
+        dll_syncLink(list, current, elem, next);
+        pthread_mutex_unlock(dll_syncMutex(list, next, &sync->tail));
+    }
+    else if (current == NULL) {
+        //sorted insert past the last node
+        DLL_LOCK(list, &sync->tail);
+        dll_syncLink(list, previous, elem, NULL);
+        pthread_mutex_unlock(&sync->tail);
+    }
+    else
+        dll_syncLink(list, previous, elem, current);
+    if (current != NULL)
+        pthread_mutex_unlock(dll_syncMutex(list, current, NULL));
+    pthread_mutex_unlock(dll_syncMutex(list, previous, &sync->head));
+    rwl_readUnlock(list->lock);
+    if (retval == -1)
+        dll_nodeRelease(list, elem);
+    return retval;
+}
+
+
+dllnodeptr dll_syncDetachFront(list_t list)
+{
+    dllsyncptr sync = list->sync;
+    rwl_readLock(list->lock);
+    DLL_LOCK(list, &sync->head);
+    dllnodeptr first = list->head;
+    if (first != NULL) {
+        DLL_LOCK(list, dll_syncMutex(list, first, NULL));
+        dllnodeptr next = first->next;
+        DLL_LOCK(list, dll_syncMutex(list, next, &sync->tail));
+        dll_syncUnlink(list, first);
+        pthread_mutex_unlock(dll_syncMutex(list, next, &sync->tail));
+        pthread_mutex_unlock(dll_syncMutex(list, first, NULL));
+    }
+    pthread_mutex_unlock(&sync->head);
+    rwl_readUnlock(list->lock);
+    return first;
+}
+
+
+dllnodeptr dll_syncDetachBack(list_t list)
+{
+    dllsyncptr sync = list->sync;
+    dllnodeptr last;
+    rwl_readLock(list->lock);
+    while (1) {
+        last = dll_syncLockBack(list);
+        if (last == NULL) {
+            pthread_mutex_unlock(&sync->tail);
+            break;
+        }
+        //the previous node comes first in the locking order as well
+        dllnodeptr previous = last->previous;
+        if (DLL_TRYLOCK(list, dll_syncMutex(list, previous,
+                &sync->head)) == 0) {
+            dll_syncUnlink(list, last);
+            pthread_mutex_unlock(dll_syncMutex(list, previous, &sync->head));
+            pthread_mutex_unlock(dll_syncMutex(list, last, NULL));
+            pthread_mutex_unlock(&sync->tail);
+            break;
+        }
+        pthread_mutex_unlock(dll_syncMutex(list, last, NULL));
+        pthread_mutex_unlock(&sync->tail);
+        sched_yield();
+    }
+    rwl_readUnlock(list->lock);
+    return last;
+}
+
+
+dllnodeptr dll_syncDetachKey(list_t list, void* key,
+        int (*is_equal)(void*, void*))
+{
+    dllsyncptr sync = list->sync;
+    rwl_readLock(list->lock);
+    dllnodeptr previous, current = dll_syncSeek(list, key, is_equal, &previous);
+    if (current != NULL) {
+        dllnodeptr next = current->next;
+        DLL_LOCK(list, dll_syncMutex(list, next, &sync->tail));
+        dll_syncUnlink(list, current);
+        pthread_mutex_unlock(dll_syncMutex(list, next, &sync->tail));
+        pthread_mutex_unlock(dll_syncMutex(list, current, NULL));
     }
-    return list->id_counter++;
+    pthread_mutex_unlock(dll_syncMutex(list, previous, &sync->head));
+    rwl_readUnlock(list->lock);
+    return current;
 }
 
 
- int dll_iteratorGetIdxWithID(list_t list, IteratorID iterID)
- {
-     if (list->iteratorsCount > 0)
-        return dll_iteratorBinarySearch(list, iterID, 0, list->iteratorsCount - 1);
-     else
-        return -1;
- }
+int dll_unrolledUnsupported(list_t list, const char* function)
+{
+    if (list == NULL || list->unrolled == NULL)
+        return 0;
+    fprintf(stderr, "%s - Error: Not available for unrolled lists\n", function);
+    return 1;
+}
 
- int dll_iteratorBinarySearch(list_t list, IteratorID key, int start, int end) {
-     int middle_idx = (end - start) / 2 + start;
-     int current_id = (list->iteratorsArray[middle_idx]).id;
-     if (current_id == key)
-         return middle_idx;
-     else if (start == end)
-         return -1;
-     else if (key < current_id && middle_idx > 0)
-         return dll_iteratorBinarySearch(list, key, 0, middle_idx - 1);
-     else if (key > current_id && middle_idx < list->iteratorsCount)
-         return dll_iteratorBinarySearch(list, key, middle_idx + 1, list->iteratorsCount - 1);
-     return -1;
- }
 
+dllunodeptr dll_unrolledNodeCreate(list_t list, dllunodeptr after)
+{
+    dllunrolledptr unrolled = list->unrolled;
+    dllunodeptr node = dll_poolAllocate(list->pool);
+    if (node == NULL)
+        return NULL;
+    node->count = 0;
+    node->iterators = -1;
+    node->previous = after;
+    node->next = (after != NULL) ? after->next : unrolled->head;
+    if (node->next != NULL)
+        node->next->previous = node;
+    else
+        unrolled->tail = node;
+    if (after != NULL)
+        after->next = node;
+    else
+        unrolled->head = node;
+    return node;
+}
 
- int dll_iteratorGetIdxWithPtr(list_t list, dllnodeptr node)
- {
-    int idx;
-    for (idx = 0; idx < list->iteratorsCount; idx++) {
-        if ((list->iteratorsArray[idx]).node == node)
-            return idx;
-    }
-    return -1;
- }
 
- /*
-  * Takes two nodes (dllnodeptr) acting as old and new
-  * finding all the iterators that point to old and updating them to point
-  * to the new node
-  * If the list is empty, it will delete all iterators
-  * Note: Will not used by the user
-  */
- void dll_iteratorUpdate(list_t list, dllnodeptr old, dllnodeptr new)
- {
-    if (dll_isempty(list))
-        dll_iteratorDeleteAll(list);
-    else {
-        int idx;
-        for (idx = 0; idx < list->iteratorsCount; idx++) {
-            if ((list->iteratorsArray[idx]).node == old)
-                (list->iteratorsArray[idx]).node = new;
-        }
-    }
- }
+void dll_unrolledNodeRelease(list_t list, dllunodeptr node)
+{
+    dllunrolledptr unrolled = list->unrolled;
+    if (node->previous != NULL)
+        node->previous->next = node->next;
+    else
+        unrolled->head = node->next;
+    if (node->next != NULL)
+        node->next->previous = node->previous;
+    else
+        unrolled->tail = node->previous;
+    dll_poolRelease(list->pool, node);
+}
 
 
-/*
- *  Sets the iterator with ID iterID
- *  to point to the head of the list
- *  Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- *      [*] On empty list, 1 is returned to indicate invalidation of iterators
- */
-int dll_iteratorBegin(list_t list, IteratorID iterID)
+void dll_unrolledIteratorsMove(list_t list, dllunodeptr from, int first,
+        dllunodeptr to, int delta)
 {
-    // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorBegin - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // provide iterator only if list isn't empty
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorBegin - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return 1;
-    }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorBegin - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
-        return -1;
+    if (__atomic_load_n(&list->iteratorsCount, __ATOMIC_SEQ_CST) == 0)
+        return;
+    int slot = from->iterators;
+    while (slot != -1) {
+        dlliterator* iterator = &(list->iteratorsArray[slot]);
+        slot = iterator->next_on_node;
+        if (iterator->offset >= first)
+            dll_iteratorPlace(list, iterator, to, iterator->offset + delta);
     }
-    (list->iteratorsArray[idx]).node = list->head;
-    return 0;
 }
 
-/*
- *  Sets the iterator with ID iterID
- *  to point to the tail of the list
- *  Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- *      [*] On empty list, 1 is returned to indicate invalidation of iterators
- */
-int dll_iteratorEnd(list_t list, IteratorID iterID)
+
+int dll_unrolledInsert(list_t list, dllunodeptr node, int offset, void* data,
+        void* (*duplicate)(void*))
 {
-    // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorEnd - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // provide iterator only if list isn't empty
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorEnd - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return 1;
+    if (node == NULL) {
+        node = dll_unrolledNodeCreate(list, NULL);
+        if (node == NULL)
+            return -1;
+        offset = 0;
     }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorEnd - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
-        return -1;
+    else if (node->count == list->unrolled->node_elems) {
+        //split the full node, moving its second half to a new node
+        dllunodeptr half = dll_unrolledNodeCreate(list, node);
+        if (half == NULL)
+            return -1;
+        int keep = node->count / 2;
+        half->count = node->count - keep;
+        memcpy(half->items, node->items + keep, half->count * sizeof(void*));
+        node->count = keep;
+        dll_unrolledIteratorsMove(list, node, keep, half, -keep);
+        if (offset > keep) {
+            node = half;
+            offset -= keep;
+        }
     }
-    (list->iteratorsArray[idx]).node = list->tail;
+    memmove(node->items + offset + 1, node->items + offset,
+            (node->count - offset) * sizeof(void*));
+    node->items[offset] = dll_dataDuplicate(list, data, duplicate);
+    node->count++;
+    dll_unrolledIteratorsMove(list, node, offset, node, 1);
+    list->size++;
+    DLL_STAT_PEAK(list);
     return 0;
 }
 
-/*
- *  Returns the object of the node that is pointed by the iterator
- *  Return values:
- *      [*] On success, the object is returned
- *      [*] On failure, NULL is returned
- */
- void* dll_iteratorGetObj(list_t list, IteratorID iterID)
- {
-     // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorGetObj - Error: DLList has not been initialized\n");
-        return NULL;
+
+int dll_unrolledInsertSorted(list_t list, void* data,
+        int (*issmaller)(void*, void*), void* (*duplicate)(void*))
+{
+    dllunodeptr node = list->unrolled->head;
+    DLL_STAT(list, searches, 1);
+    //the element goes into the first node whose last element is bigger
+    while (node != NULL) {
+        DLL_STAT(list, search_visits, 1);
+        DLL_STAT(list, compares, 1);
+        if ((*issmaller)(data, node->items[node->count - 1]))
+            break;
+        node = node->next;
     }
-    // provide iterator only if list isn't empty
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorGetObj - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return NULL;
+    if (node == NULL) {
+        node = list->unrolled->tail;
+        return dll_unrolledInsert(list, node, node != NULL ? node->count : 0,
+                data, duplicate);
     }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorGetObj - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
-        return NULL;
+    //after the elements of the node that are not bigger
+    int low = 0, high = node->count - 1;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        DLL_STAT(list, compares, 1);
+        if ((*issmaller)(data, node->items[middle]))
+            high = middle;
+        else
+            low = middle + 1;
     }
-    return (list->iteratorsArray[idx]).node->data;
- }
+    return dll_unrolledInsert(list, node, low, data, duplicate);
+}
 
-/*
- *  Sets the iterator to the next node
- *  If by advancing, the iterator is requested to point after the tail
- *  of the list, 2 is returned
- *  Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- *      [*] On empty list, 1 is returned to indicate invalidation of iterators
- *      [*] On the case described above, 2 is returned
- */
- int dll_iteratorNext(list_t list, IteratorID iterID)
- {
-     // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorNext - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    // provide iterator only if list isn't empty
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorNext - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
+
+void* dll_unrolledRemove(list_t list, dllunodeptr node, int offset)
+{
+    int node_elems = list->unrolled->node_elems;
+    void* data = node->items[offset];
+    list->size--;
+    if (list->size == 0) {
         dll_iteratorDeleteAll(list);
-        return 1;
-    }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorNext - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
-        return -1;
-    }
-    // check the case of calling this function on a iterator that points to the
-    // tail of the list
-    if ((list->iteratorsArray[idx]).node == list->tail) {
-        return 2;
+        dll_unrolledNodeRelease(list, node);
+        return data;
     }
-    (list->iteratorsArray[idx]).node = (list->iteratorsArray[idx]).node->next;
-    return 0;
- }
-
- /*
- *  Sets the iterator to the previous node
- *  If by requesting the previous node, the iterator points before the head
- *  of the list, 2 is returned
- *  Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- *      [*] On empty list, 1 is returned to indicate invalidation of iterators
- *      [*] On the case described above, 2 is returned
- */
- int dll_iteratorPrev(list_t list, IteratorID iterID)
- {
-     // check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorRequest - Error: DLList has not been initialized\n");
-        return -1;
+    node->count--;
+    memmove(node->items + offset, node->items + offset + 1,
+            (node->count - offset) * sizeof(void*));
+    //iterators on the element move on to the next one, unless it was the last
+    //element of the node
+    dll_unrolledIteratorsMove(list, node, offset + 1, node, -1);
+    if (offset == node->count) {
+        if (node->next != NULL)
+            dll_unrolledIteratorsMove(list, node, offset, node->next, -offset);
+        else if (offset > 0)
+            dll_unrolledIteratorsMove(list, node, offset, node, -1);
+        else
+            dll_unrolledIteratorsMove(list, node, 0, node->previous,
+                    node->previous->count - 1);
     }
-    // provide iterator only if list isn't empty
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorRequest - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return 1;
+    if (node->count == 0) {
+        dll_unrolledNodeRelease(list, node);
+        return data;
     }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorPrev - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
-        return -1;
+    if (node->count >= node_elems / 2)
+        return data;
+    //merge with the next node, or else with the previous one, if they fit
+    dllunodeptr first = node, second = node->next;
+    if (second == NULL || first->count + second->count > node_elems) {
+        first = node->previous;
+        second = node;
     }
-    // check the case of calling this function on a iterator that points to the
-    // head of the list
-    if (list->iteratorsArray[idx].node == list->head) {
-        return 2;
+    if (first != NULL && first->count + second->count <= node_elems) {
+        memcpy(first->items + first->count, second->items,
+                second->count * sizeof(void*));
+        dll_unrolledIteratorsMove(list, second, 0, first, first->count);
+        first->count += second->count;
+        dll_unrolledNodeRelease(list, second);
     }
-    (list->iteratorsArray[idx]).node = (list->iteratorsArray[idx]).node->previous;
-    return 0;
+    return data;
 }
 
-/*
- * Acts both as a copy constructor and copy function
- * When you need copy constructor functionality, dest IteratorID must be
- * NULL, and this function will allocate a new iterator setting it
- * to point to the node that src Iterator points
- * When you need simple copy functionality, the function will copy the
- * address of the node that src Iterator points to the node of dest Iterator
- * Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- *      [*] On empty list, 1 is returned to indicate the invalidation of the
- *          iterators
- *      [*] On iteratorIdxOutOfBounds error, 2 is returned
- *
- */
-int dll_iteratorCopy(list_t list, const IteratorID src, IteratorID *dest)
+
+int dll_unrolledFind(list_t list, void* key, int (*is_equal)(void*, void*),
+        dllunodeptr* nodeptr)
 {
-    // check if list is null or empty
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorCopy - Error: DLList has not been initialized\n");
-        return -1;
-    }
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorCopy - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return 1;
+    dllunodeptr node;
+    int offset;
+    DLL_STAT(list, searches, 1);
+    for (node = list->unrolled->head; node != NULL; node = node->next)
+        for (offset = 0; offset < node->count; offset++) {
+            DLL_STAT(list, search_visits, 1);
+            DLL_STAT(list, compares, 1);
+            if ((*is_equal)(key, node->items[offset])) {
+                *nodeptr = node;
+                return offset;
+            }
+        }
+    return -1;
+}
+
+
+dllunodeptr dll_unrolledAt(list_t list, int position, int* offset)
+{
+    dllunodeptr node;
+    if (position < list->size / 2) {
+        node = list->unrolled->head;
+        while (position >= node->count) {
+            position -= node->count;
+            node = node->next;
+        }
+        *offset = position;
     }
-    // check if src iterator is valid
-    int srcIdx = dll_iteratorGetIdxWithID(list, src);
-    if (srcIdx == -1) {
-        fprintf(stderr, "dll_iteratorCopy - Error: Source iterator doesn't exist\n");
-        return 2;
+    else {
+        //count from the tail instead
+        position = list->size - 1 - position;
+        node = list->unrolled->tail;
+        while (position >= node->count) {
+            position -= node->count;
+            node = node->previous;
+        }
+        *offset = node->count - 1 - position;
     }
-    // check which functionality is needed
-    if (*dest == -1) {
-        // copy constructor functionality
-        *dest = dll_iteratorRequest(list);
-        if (*dest == -1) {
-            fprintf(stderr, "dll_iteratorCopy - Error: Could not allocate dest"
-            "iterator\n");
+    return node;
+}
+
+
+int dll_unrolledRepack(list_t alist, list_t blist)
+{
+    int node_elems = alist->unrolled->node_elems;
+    int count = (blist->size + node_elems - 1) / node_elems;
+    dllunodeptr spare = NULL, node, current;
+    int i;
+    //allocate all the new nodes first, so that a failure leaves b intact
+    for (i = 0; i < count; i++) {
+        node = dll_poolAllocate(alist->pool);
+        if (node == NULL) {
+            perror("dll_nodesAdopt - Error: ");
+            while (spare != NULL) {
+                node = spare;
+                spare = spare->next;
+                dll_poolRelease(alist->pool, node);
+            }
             return -1;
         }
-        // set dest iterator node to point to src iterator node
-        int destIdx = dll_iteratorGetIdxWithID(list, *dest);
-        (list->iteratorsArray[destIdx]).node =
-                (list->iteratorsArray[srcIdx]).node;
-        return 0;
+        node->next = spare;
+        spare = node;
     }
-    else {
-        // simple copy functionality
-        // set dest iterator node to point to src iterator node
-        int destIdx = dll_iteratorGetIdxWithID(list, *dest);
-        if (destIdx == -1) {
-            fprintf(stderr, "dll_iteratorCopy - Error: Destination iterator"
-                    " doesn't exist\n");
-            return -1;
+    dll_iteratorDeleteAll(blist);
+    //fill the new nodes up, the last one keeping the remainder
+    dllunodeptr head = NULL, tail = NULL;
+    for (current = blist->unrolled->head; current != NULL;
+            current = current->next)
+        for (i = 0; i < current->count; i++) {
+            if (tail == NULL || tail->count == node_elems) {
+                node = spare;
+                spare = spare->next;
+                node->count = 0;
+                node->iterators = -1;
+                node->previous = tail;
+                node->next = NULL;
+                if (tail == NULL)
+                    head = node;
+                else
+                    tail->next = node;
+                tail = node;
+            }
+            tail->items[tail->count++] = current->items[i];
         }
-        (list->iteratorsArray[destIdx]).node =
-                (list->iteratorsArray[srcIdx]).node;
-        return 0;
-    }
+    blist->unrolled->head = head;
+    blist->unrolled->tail = tail;
+    dll_poolDestroy(blist->pool);
+    blist->pool = NULL;
+    return 0;
 }
 
- /*
-  * Deletes the current node pointed by the iterator
-  * After the deletion the iterator points to the next element of the list
-  * (towards the tail). If the element to be destroyed is the last element of the
-  * list, which means that the list will be empty, all the iterators are
-  * invalidated
-  * Return values:
-  *         [*] On success, 0 is returned
-  *         [*] On failure, -1 is returned
-  *         [*] On empty list, 1 is returned to indicate invalidation of
-  *             iterators
-  */
-int dll_iteratorDeleteCurrentNode(list_t list, IteratorID iterID,
-        void (*free_data)(void*))
+
+void* dll_unrolledSeek(list_t list, void* key, int (*issmaller)(void*, void*))
 {
-    // check if list is null or empty
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error: DLList has not been initialized\n");
-        return -1;
+    dllunodeptr node = list->unrolled->head;
+    DLL_STAT(list, searches, 1);
+    //the element is in the first node whose last element is not smaller
+    while (node != NULL) {
+        DLL_STAT(list, search_visits, 1);
+        DLL_STAT(list, compares, 1);
+        if (!(*issmaller)(node->items[node->count - 1], key))
+            break;
+        node = node->next;
     }
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error: DLList is empty\n"
-                "\tDeleting all iterators now...\n");
-        // invalidate - delete all iterators
-        dll_iteratorDeleteAll(list);
-        return 1;
+    if (node == NULL)
+        return NULL;
+    int low = 0, high = node->count - 1;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        DLL_STAT(list, compares, 1);
+        if ((*issmaller)(node->items[middle], key))
+            low = middle + 1;
+        else
+            high = middle;
     }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
+    return node->items[low];
+}
+
+
+int dll_dequeUnsupported(list_t list, const char* function)
+{
+    if (list == NULL || list->deque == NULL)
+        return 0;
+    fprintf(stderr, "%s - Error: Not available for lock-free deques\n",
+            function);
+    return 1;
+}
+
+
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+int dll_dequeCreate(list_t list)
+{
+    void* deque;
+    //the anchor is swapped as a whole, so it is aligned to its size
+    if (posix_memalign(&deque, sizeof(dllanchor),
+            sizeof(struct DoublyLinkedListDeque)) != 0) {
+        fprintf(stderr, "dll_init_deque - Error: Cannot allocate the deque\n");
         return -1;
     }
-    //set current node
-    dllnodeptr current = (list->iteratorsArray[idx]).node;
-    //set iterator to the next element (towards the end of the list)
-    int setIteratorToEnd = 0;
-    if (dll_iteratorNext(list, iterID) == 2) {
-        //current node is tail node, hence dll_iteratorNext returned 2
-        //Setting the iterator to the end of the list, must occur after
-        //the deletion
-        setIteratorToEnd = 1;
+    list->deque = deque;
+    list->deque->anchor = dll_dequeAnchor(NULL, NULL, DLL_DEQUE_STABLE);
+    return 0;
+}
+
+
+void dll_dequeDestroy(list_t list)
+{
+    if (list->deque == NULL)
+        return;
+    free(list->deque);
+    list->deque = NULL;
+    //the nodes popped by the other threads wait for them
+    pthread_once(&dll_hazardOnce, &dll_hazardKeyCreate);
+    if (dll_hazardKeyError)
+        return;
+    dllhazardsptr record = pthread_getspecific(dll_hazardKey);
+    if (record != NULL)
+        dll_hazardScan(record);
+}
+
+
+int dll_dequeInsert(list_t list, void* data, void* (*duplicate)(void*),
+        int end)
+{
+    dlldequeptr deque = list->deque;
+    dllhazardsptr record = dll_hazardRecord();
+    dllnodeptr node = (record != NULL) ? dll_nodeAllocate(list) : NULL;
+    int i;
+    if (node == NULL) {
+        perror("dll_dequeInsert - Error: ");
+        return -1;
     }
-    //implement delete
-    if (current == list->head) {
-            if (current != list->tail) {
-                //first node doesn't have previous
-                (current->next)->previous = NULL;
-                list->head = current->next;
-                list->size--;
-                (*free_data)((void*) current->data);
-                free(current);
-                current = NULL;
-            }
-            else {
-                // one and only node left in list
-                list->head = NULL;
-                list->tail = NULL;
-                list->size--;
-                (*free_data)((void*) current->data);
-                free(current);
-                current = NULL;
-                // all the elements of the list have been deleted,
-                // indicate empty list
-                dll_iteratorDeleteAll(list);
-                return 1;
-            }
+    dll_nodeSetData(list, node, data, duplicate);
+    //nothing lies beyond the new end. The node is counted before it can be
+    //popped, so that the size never drops below 0
+    *dll_dequeLink(node, end) = NULL;
+    __atomic_add_fetch(&list->size, 1, __ATOMIC_RELAXED);
+    DLL_STAT_PEAK(list);
+    while (1) {
+        dllanchor anchor = dll_dequeRead(deque);
+        dllnodeptr ends[2] = { dll_dequeEnd(anchor, DLL_DEQUE_FRONT),
+                dll_dequeEnd(anchor, DLL_DEQUE_BACK) };
+        if (ends[end] == NULL) {
+            *dll_dequeLink(node, !end) = NULL;
+            if (dll_dequeSwap(deque, anchor,
+                    dll_dequeAnchor(node, node, DLL_DEQUE_STABLE)))
+                break;
         }
-        else if (current == list->tail) {
-            list->tail = current->previous;
-            //last node doesn't have next
-            (current->previous)->next = NULL;
-            list->size--;
-            (*free_data)((void*)current->data);
-            free(current);
-            current = NULL;
-            if (setIteratorToEnd) {
-                if (dll_iteratorEnd(list, iterID) < 0) {
-                    fprintf(stderr, "dll_iteratorDeleteCurrentNode - Error:"
-                            "Could not set iterator to the end of the list\n");
-                    return -1;
-                }
+        else if (dll_dequeStatus(anchor) == DLL_DEQUE_STABLE) {
+            //the node links to the old end right away, while the old end
+            //links to the node once the anchor is stabilized
+            *dll_dequeLink(node, !end) = ends[end];
+            ends[end] = node;
+            dllanchor pushed = dll_dequeAnchor(ends[DLL_DEQUE_FRONT],
+                    ends[DLL_DEQUE_BACK], end + 1);
+            if (dll_dequeSwap(deque, anchor, pushed)) {
+                dll_dequeStabilize(list, record, pushed);
+                break;
             }
         }
-        else {
-            (current->previous)->next = current->next;
-            (current->next)->previous = current->previous;
-            list->size--;
-            (*free_data)((void*)current->data);
-            free(current);
-            current = NULL;
-        }
+        else
+            dll_dequeStabilize(list, record, anchor);
+    }
+    for (i = 0; i < DLL_HAZARDS; i++)
+        __atomic_store_n(&record->hazards[i], NULL, __ATOMIC_RELEASE);
     return 0;
 }
 
-/*
- *  Deletes the iterator pointed by iterID
- *  and then invalidating the iterID
- *  Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- */
-int dll_iteratorDelete(list_t list, IteratorID iterID)
+
+int dll_dequePop(list_t list, int end, void* out)
 {
-    // firstly check if list is null or empty
-     if (list == NULL) {
-        fprintf(stderr, "dll_iteratorDelete - Error: DLList has not been initialized\n");
+    dlldequeptr deque = list->deque;
+    dllhazardsptr record = dll_hazardRecord();
+    dllnodeptr node;
+    int i;
+    if (record == NULL) {
+        perror("dll_dequePop - Error: ");
         return -1;
     }
-    if(dll_isempty(list)) {
-        fprintf(stderr, "dll_iteratorDelete - Error: DLList is empty\n");
-        //in that case, no iterators should exist
-        dll_iteratorDeleteAll(list);
-        return -1;
+    while (1) {
+        dllanchor anchor = dll_dequeRead(deque);
+        dllnodeptr ends[2] = { dll_dequeEnd(anchor, DLL_DEQUE_FRONT),
+                dll_dequeEnd(anchor, DLL_DEQUE_BACK) };
+        node = ends[end];
+        if (node == NULL)
+            break;
+        if (ends[DLL_DEQUE_FRONT] == ends[DLL_DEQUE_BACK]) {
+            //single node, whose anchor is always stable
+            if (dll_dequeSwap(deque, anchor,
+                    dll_dequeAnchor(NULL, NULL, DLL_DEQUE_STABLE)))
+                break;
+        }
+        else if (dll_dequeStatus(anchor) == DLL_DEQUE_STABLE) {
+            //the node is published before reading its link, and is still
+            //in the deque (so not retired yet) if the anchor is unchanged
+            __atomic_store_n(&record->hazards[0], node, __ATOMIC_SEQ_CST);
+            if (dll_dequeRead(deque).word != anchor.word)
+                continue;
+            ends[end] = __atomic_load_n(dll_dequeLink(node, !end),
+                    __ATOMIC_ACQUIRE);
+            if (dll_dequeSwap(deque, anchor, dll_dequeAnchor(
+                    ends[DLL_DEQUE_FRONT], ends[DLL_DEQUE_BACK],
+                    DLL_DEQUE_STABLE)))
+                break;
+        }
+        else
+            dll_dequeStabilize(list, record, anchor);
     }
-    // find iterator's idx
-    int idx = dll_iteratorGetIdxWithID(list, iterID);
-    if (idx == -1) {
-        fprintf(stderr, "dll_iteratorDelete - Error: "
-                "Iterator with ID == %d wasn't found\n", iterID);
-        return -1;
+    for (i = 0; i < DLL_HAZARDS; i++)
+        __atomic_store_n(&record->hazards[i], NULL, __ATOMIC_RELEASE);
+    if (node == NULL)
+        return 1;
+    //the node is out of the deque and this thread is the only one to own it
+    __atomic_sub_fetch(&list->size, 1, __ATOMIC_RELAXED);
+    if (out != NULL && list->elem_size > 0)
+        memcpy(out, node->payload, list->elem_size);
+    else if (out != NULL)
+        *(void**) out = node->data;
+    dll_hazardRetire(record, node);
+    return 0;
+}
+
+
+void dll_dequeDrain(list_t list, void (*free_data)(void*))
+{
+    dlldequeptr deque = list->deque;
+    dllanchor anchor = dll_dequeRead(deque);
+    dllnodeptr back = dll_dequeEnd(anchor, DLL_DEQUE_BACK);
+    int status = dll_dequeStatus(anchor);
+    //complete a push left pending, no other thread is using the list
+    if (status != DLL_DEQUE_STABLE) {
+        dllnodeptr newest = dll_dequeEnd(anchor, status - 1);
+        *dll_dequeLink(*dll_dequeLink(newest, !(status - 1)), status - 1) =
+                newest;
     }
-    list->iteratorsCount--;
-    //keep a backup of the iterator marked for removal, in case realloc fails
-    dlliterator backup;
-    backup.id = idx;
-    backup.node = (list->iteratorsArray[idx]).node;
-    // Watch case in which the number of iterators after delete is 0
-    memmove(&(list->iteratorsArray[idx]), &(list->iteratorsArray[idx+1]),
-    (list->iteratorsCount - idx)*sizeof(dlliterator));
-    void* tmp = realloc(list->iteratorsArray, list->iteratorsCount * sizeof(dlliterator));
-    if ((tmp == NULL) && (list->iteratorsCount != 0)) {
-        //error with realloc
-        fprintf(stderr, "dll_iteratorDelete - Error: Failed to delete iterator with ID == %d\n", iterID);
-        //undo memmove
-        memmove(&(list->iteratorsArray[idx+1]), &(list->iteratorsArray[idx]),
-                (list->iteratorsCount - idx)*sizeof(dlliterator));
-        //restore backup
-        (list->iteratorsArray[idx]).id = backup.id;
-        (list->iteratorsArray[idx]).node = backup.node;
-        //restore counter
-        list->iteratorsCount++;
-        return -1;
+    //the back node may still link to a popped node
+    dllnodeptr current = dll_dequeEnd(anchor, DLL_DEQUE_FRONT);
+    while (current != NULL) {
+        dllnodeptr next = (current != back) ? current->next : NULL;
+        dll_nodeFreeData(list, current, free_data);
+        dll_nodeRelease(list, current);
+        current = next;
     }
-    else
-        list->iteratorsArray = tmp;
-    iterID = -1;
-    return 0;
+    deque->anchor = dll_dequeAnchor(NULL, NULL, DLL_DEQUE_STABLE);
+    list->size = 0;
 }
 
-/*
- *  Deletes all the iterators
- *  Return values:
- *      [*] On success, 0 is returned
- *      [*] On failure, -1 is returned
- */
-int dll_iteratorDeleteAll(list_t list)
+
+dllanchor dll_dequeRead(dlldequeptr deque)
 {
-    //firstly check if list is null
-    if (list == NULL) {
-        fprintf(stderr, "dll_iteratorDeleteAll - Error: DLList has not been initialized\n");
-        return -1;
+    dllanchor anchor;
+    //a compare-and-swap that at most rewrites the same value is the only
+    //atomic 16-byte read
+    anchor.word = __sync_val_compare_and_swap(&deque->anchor.word, 0, 0);
+    return anchor;
+}
+
+
+int dll_dequeSwap(dlldequeptr deque, dllanchor expected, dllanchor next)
+{
+    return __sync_bool_compare_and_swap(&deque->anchor.word, expected.word,
+            next.word);
+}
+
+
+dllanchor dll_dequeAnchor(dllnodeptr front, dllnodeptr back, int status)
+{
+    dllanchor anchor;
+    anchor.ends[DLL_DEQUE_FRONT] = (uintptr_t) front;
+    anchor.ends[DLL_DEQUE_BACK] = (uintptr_t) back | status;
+    return anchor;
+}
+
+
+dllnodeptr dll_dequeEnd(dllanchor anchor, int end)
+{
+    return (dllnodeptr) (anchor.ends[end] & ~(uintptr_t) DLL_DEQUE_STATUS);
+}
+
+
+int dll_dequeStatus(dllanchor anchor)
+{
+    return anchor.ends[DLL_DEQUE_BACK] & DLL_DEQUE_STATUS;
+}
+
+
+dllnodeptr* dll_dequeLink(dllnodeptr node, int end)
+{
+    return (end == DLL_DEQUE_FRONT) ? &node->previous : &node->next;
+}
+
+
+void dll_dequeStabilize(list_t list, dllhazardsptr record, dllanchor anchor)
+{
+    dlldequeptr deque = list->deque;
+    int end = dll_dequeStatus(anchor) - 1;
+    //both nodes are published before they are read, and are still in the
+    //deque once published if the anchor is unchanged
+    dllnodeptr newest = dll_dequeEnd(anchor, end);
+    __atomic_store_n(&record->hazards[0], newest, __ATOMIC_SEQ_CST);
+    if (dll_dequeRead(deque).word != anchor.word)
+        return;
+    dllnodeptr neighbour = __atomic_load_n(dll_dequeLink(newest, !end),
+            __ATOMIC_ACQUIRE);
+    __atomic_store_n(&record->hazards[1], neighbour, __ATOMIC_SEQ_CST);
+    if (dll_dequeRead(deque).word != anchor.word)
+        return;
+    dllnodeptr outer = __atomic_load_n(dll_dequeLink(neighbour, end),
+            __ATOMIC_ACQUIRE);
+    if (outer != newest) {
+        if (dll_dequeRead(deque).word != anchor.word)
+            return;
+        if (!__atomic_compare_exchange_n(dll_dequeLink(neighbour, end), &outer,
+                newest, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            return;
+    }
+    dll_dequeSwap(deque, anchor, dll_dequeAnchor(
+            dll_dequeEnd(anchor, DLL_DEQUE_FRONT),
+            dll_dequeEnd(anchor, DLL_DEQUE_BACK), DLL_DEQUE_STABLE));
+}
+#else
+int dll_dequeCreate(list_t list)
+{
+    fprintf(stderr, "dll_init_deque - Error: Lock-free deques need a 16-byte "
+            "compare-and-swap (-mcx16 on x86-64)\n");
+    return -1;
+}
+
+
+void dll_dequeDestroy(list_t list)
+{
+}
+
+
+int dll_dequeInsert(list_t list, void* data, void* (*duplicate)(void*),
+        int end)
+{
+    return -1;
+}
+
+
+int dll_dequePop(list_t list, int end, void* out)
+{
+    return -1;
+}
+
+
+void dll_dequeDrain(list_t list, void (*free_data)(void*))
+{
+}
+#endif
+
+
+void dll_hazardKeyCreate(void)
+{
+    if (pthread_key_create(&dll_hazardKey, &dll_hazardExit) != 0)
+        dll_hazardKeyError = 1;
+}
+
+
+dllhazardsptr dll_hazardRecord(void)
+{
+    pthread_once(&dll_hazardOnce, &dll_hazardKeyCreate);
+    if (dll_hazardKeyError)
+        return NULL;
+    dllhazardsptr record = pthread_getspecific(dll_hazardKey);
+    int i;
+    if (record != NULL)
+        return record;
+    //take over the record of an exited thread, if there is one
+    for (record = __atomic_load_n(&dll_hazardRecords, __ATOMIC_ACQUIRE);
+            record != NULL; record = record->next) {
+        int idle = 0;
+        if (__atomic_compare_exchange_n(&record->active, &idle, 1, 0,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            break;
     }
-    if (list->iteratorsCount > 0) {
-        free(list->iteratorsArray);
-        list->iteratorsArray = (void*) NULL;
-        list->iteratorsCount = 0;
+    if (record == NULL) {
+        record = malloc(sizeof(struct DoublyLinkedListHazards));
+        if (record == NULL)
+            return NULL;
+        record->retired = malloc(DLL_HAZARD_RETIRED * sizeof(dllnodeptr));
+        if (record->retired == NULL) {
+            free(record);
+            return NULL;
+        }
+        record->retiredCount = 0;
+        record->retiredCapacity = DLL_HAZARD_RETIRED;
+        for (i = 0; i < DLL_HAZARDS; i++)
+            record->hazards[i] = NULL;
+        record->active = 1;
+        //records are never unlinked, so pushing them is enough
+        record->next = __atomic_load_n(&dll_hazardRecords, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&dll_hazardRecords, &record->next,
+                record, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            ;
     }
-    return 0;
+    if (pthread_setspecific(dll_hazardKey, record) != 0) {
+        __atomic_store_n(&record->active, 0, __ATOMIC_RELEASE);
+        return NULL;
+    }
+    return record;
+}
+
+
+void dll_hazardExit(void* arg)
+{
+    dllhazardsptr record = arg;
+    int i;
+    for (i = 0; i < DLL_HAZARDS; i++)
+        __atomic_store_n(&record->hazards[i], NULL, __ATOMIC_RELEASE);
+    dll_hazardScan(record);
+    __atomic_store_n(&record->active, 0, __ATOMIC_RELEASE);
+}
+
+
+void dll_hazardRetire(dllhazardsptr record, dllnodeptr node)
+{
+    if (record->retiredCount == record->retiredCapacity) {
+        dll_hazardScan(record);
+        //nodes still published take as many threads, so make room for them,
+        //keeping the scans rare
+        if (record->retiredCount > record->retiredCapacity / 2) {
+            dllnodeptr* grown = realloc(record->retired,
+                    2 * record->retiredCapacity * sizeof(dllnodeptr));
+            if (grown != NULL) {
+                record->retired = grown;
+                record->retiredCapacity *= 2;
+            }
+        }
+        //out of memory, wait for the nodes to be unpublished
+        while (record->retiredCount == record->retiredCapacity) {
+            sched_yield();
+            dll_hazardScan(record);
+        }
+    }
+    record->retired[record->retiredCount++] = node;
+}
+
+
+void dll_hazardScan(dllhazardsptr record)
+{
+    int i, kept = 0;
+    for (i = 0; i < record->retiredCount; i++) {
+        dllnodeptr node = record->retired[i];
+        dllhazardsptr other;
+        int published = 0, hazard;
+        for (other = __atomic_load_n(&dll_hazardRecords, __ATOMIC_ACQUIRE);
+                other != NULL && !published; other = other->next)
+            for (hazard = 0; hazard < DLL_HAZARDS; hazard++)
+                if (__atomic_load_n(&other->hazards[hazard],
+                        __ATOMIC_SEQ_CST) == node)
+                    published = 1;
+        //deque nodes are never pooled
+        if (published)
+            record->retired[kept++] = node;
+        else
+            free(node);
+    }
+    record->retiredCount = kept;
+}
+
+
+#ifdef DLL_STATS
+void dll_statsPeak(list_t list)
+{
+    unsigned long size = __atomic_load_n(&list->size, __ATOMIC_RELAXED);
+    unsigned long peak = __atomic_load_n(&list->stats.peak_size,
+            __ATOMIC_RELAXED);
+    while (size > peak && !__atomic_compare_exchange_n(&list->stats.peak_size,
+            &peak, size, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+
+int dll_statsLock(list_t list, pthread_mutex_t* mutex)
+{
+    DLL_STAT(list, lock_acquisitions, 1);
+    if (pthread_mutex_trylock(mutex) == 0)
+        return 0;
+    DLL_STAT(list, lock_contentions, 1);
+    return pthread_mutex_lock(mutex);
 }
 
+
+int dll_statsTrylock(list_t list, pthread_mutex_t* mutex)
+{
+    int retval = pthread_mutex_trylock(mutex);
+    if (retval == 0)
+        DLL_STAT(list, lock_acquisitions, 1);
+    else
+        DLL_STAT(list, lock_contentions, 1);
+    return retval;
+}
+#endif
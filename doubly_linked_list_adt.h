@@ -8,12 +8,41 @@
 #ifndef DOUBLYLINKEDLIST_ADT_H
 #define	DOUBLYLINKEDLIST_ADT_H
 
+#include <stddef.h>
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
     typedef struct DoublyLinkedList_ADT *list_t;
     typedef int IteratorID;
+
+    /*
+     * Operation statistics of a list, see dll_stats
+     */
+    struct dll_stats
+    {
+        //elements inserted at either end (single and batched inserts),
+        //in sorted order, before or after a key and at a position (other
+        //than the two ends)
+        unsigned long inserts_back, inserts_front, inserts_sorted,
+                inserts_keyed, inserts_at;
+        //elements deleted (or popped) by key, at either end, through an
+        //iterator, at a position and by predicate (dll_remove_if)
+        unsigned long deletes_key, deletes_front, deletes_back,
+                deletes_iterator, deletes_at, deletes_if;
+        //searches for an element or a position (edit_data, delete,
+        //insert_sorted, insert_before/after, search_sorted), along with the
+        //nodes (or hash slots) they visited and the comparator calls they made
+        unsigned long searches, search_visits, compares;
+        unsigned long duplicates;       // calls of the duplicate functions
+        unsigned long iterator_lookups; // iterator IDs resolved
+        //mutexes taken by concurrent lists, and how many were held by
+        //another thread at the time
+        unsigned long lock_acquisitions, lock_contentions;
+        unsigned long peak_size;
+        int size;
+    };
     
     /*
      * Function responsible for initializing the Doubly Linked list_t ADT
@@ -22,6 +51,112 @@ extern "C" {
      *      [*] On failure,  -1 is returned
      */
     int dll_init(list_t*);
+    /*
+     * Function responsible for initializing the Doubly Linked list_t ADT with
+     * a node pool. Nodes are carved out of chunks of `chunk_nodes` nodes and
+     * deleted nodes are recycled, so inserts and deletes rarely reach malloc
+     * and free. A `chunk_nodes` of 0 (or less) selects the default chunk size
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_init_pooled(list_t*, int);
+    /*
+     * Function responsible for initializing the Doubly Linked list_t ADT for
+     * fixed-size elements of `elem_size` bytes, which are copied (memcpy) into
+     * the nodes themselves instead of being duplicated. The duplicate and
+     * free_data arguments of the rest of the API are ignored for such lists
+     * (they may be NULL), as each element lives and dies with its node
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_init_inline(list_t*, size_t);
+    /*
+     * Same as dll_init_inline, with the nodes served by a node pool
+     * (see dll_init_pooled)
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_init_inline_pooled(list_t*, size_t, int);
+    /*
+     * Function responsible for initializing the Doubly Linked list_t ADT for
+     * use by many threads at once. Every node carries a mutex, and inserts,
+     * deletes, lookups (edit_data, get_front, get_back) and dll_size lock only
+     * the nodes they walk over (hand over hand), so that operations on
+     * different parts of the list run in parallel. The bulk operations
+     * (insert_many, insert_sorted_many, merge_sorted, sort, parallel_for_each,
+     * reduce, remove_if) lock the whole list instead, while print, copy,
+     * append, destroy and the iterators must not run alongside other
+     * operations on the list.
+     * Elements are stored inline if `elem_size` is not 0 (see dll_init_inline).
+     * Node pools, the skip index and the hash index are not available
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_init_concurrent(list_t*, size_t);
+    /*
+     * Function responsible for initializing the Doubly Linked list_t ADT as
+     * a lock-free deque, which many threads push to and pop from at both ends
+     * without taking any lock: both ends live in one anchor updated with a
+     * 16-byte compare-and-swap (M. M. Michael's deque), and popped nodes are
+     * freed once no thread holds a hazard pointer to them. The methods of the
+     * ends (push, pop, pop_*_into, insert_at, adopt_at and delete at the
+     * front and back) and dll_size are available, dll_clear and dll_destroy
+     * as long as they do not run alongside them, and the other methods are
+     * refused. Elements are stored inline if `elem_size` is not 0 (see
+     * dll_init_inline)
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned (as on platforms without a
+     *          16-byte compare-and-swap, see the Makefile)
+     */
+    int dll_init_deque(list_t*, size_t);
+    /*
+     * Function responsible for initializing the Doubly Linked list_t ADT as
+     * an arena list: a pooled list (see dll_init_pooled) whose elements may
+     * be built in storage handed out by dll_arena_alloc. When the elements
+     * need no free_data, dll_clear and dll_destroy release everything in
+     * O(number of chunks and blocks), without visiting the nodes
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_init_arena(list_t*, int);
+    /*
+     * Function responsible for initializing the Doubly Linked list_t ADT as
+     * an unrolled list: its nodes (served by a node pool) hold up to
+     * `node_elems` elements each (0 selects the default, 16), so that
+     * searches, sorted inserts and iterations walk one node per run of
+     * elements. A full node is split in two when an element is added to it,
+     * and a node left less than half full by a delete is merged with a
+     * neighbour. Elements are duplicated, never stored inline, and iterators
+     * keep pointing to the same elements as nodes are split and merged.
+     * Unrolled lists can be appended to unrolled lists only. The other bulk
+     * operations (insert_many, insert_sorted_many, remove_if, load,
+     * merge_sorted, splice, split_at, sort, parallel_for_each, reduce), the
+     * indexes and the finger are not available
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_init_unrolled(list_t*, int);
+    /*
+     * Function that returns `size` bytes of pointer-aligned storage carved
+     * out of big blocks owned by an arena list, for elements to be inserted
+     * into that list (by a duplicate function, or before an adopt insert).
+     * The storage is only freed along with all the rest, by dll_clear and
+     * dll_destroy, so such elements must not be freed with free_data.
+     * It does not take the list lock, so that duplicate functions (which run
+     * under it) can call it. Lists whose elements live in their arena cannot
+     * give them away with dll_splice or dll_split_at
+     * Return values:
+     *      [*] On success, the storage is returned
+     *      [*] On failure, NULL is returned
+     */
+    void* dll_arena_alloc(list_t, size_t);
     /*
      * Function returning the size of the list
      */
@@ -33,6 +168,15 @@ extern "C" {
      *      [*] on non empty list, 0 is returned
      */
     int dll_isempty(list_t);
+    /*
+     * Function responsible for filling the given struct with the operation
+     * statistics of the list. Statistics are kept only when the library is
+     * compiled with -DDLL_STATS, and cost nothing otherwise
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure (or without statistics),  -1 is returned
+     */
+    int dll_stats(list_t, struct dll_stats*);
     /*
      * Function responsible for printing the list in this fashion:
      *          "element -> element -> element" (delimiter "->")
@@ -43,6 +187,10 @@ extern "C" {
     void dll_print(const list_t, void (*print_data)(void*), int);
     /*
      * Function responsible for inserting an element at the end of the list
+     * The element is duplicated with the duplicate function (3rd argument),
+     * which must not be NULL, except for inline lists (see dll_init_inline),
+     * as is the case for every insert function of the API. The adopt
+     * variants (see dll_adopt_at_back) hand the element itself to the list
      * Return values:
      *      [*] On success,  0 is returned
      *      [*] On failure,  -1 is returned
@@ -60,6 +208,64 @@ extern "C" {
      *      [*] On failure,  -1 is returned
      */
     int dll_insert_at_front(list_t, void*, void* (*)(void*));
+    /*
+     * Function responsible for inserting `count` elements (the items array) at
+     * the end of the list, in the order they are given. Each element is
+     * duplicated as in dll_insert_at_back, but all the nodes are allocated at
+     * once (as a single block for pooled lists) and linked in one pass, under
+     * one acquisition of the list lock
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned (the list is left untouched)
+     */
+    int dll_insert_many_at_back(list_t, void**, int, void* (*)(void*));
+    /*
+     * Function responsible for inserting an element at the end of the list
+     * without duplicating it: the list takes ownership of the given object,
+     * which is later freed by the list (or handed back by dll_pop_*)
+     * Inline lists (see dll_init_inline) copy the element into the node
+     * instead, the caller keeping the given object. Along with dll_pop_front
+     * and dll_pop_back (dll_pop_*_into for inline lists), this is how a list
+     * is used as a queue or a deque: on
+     * concurrent lists, adopts and pops at opposite ends lock disjoint
+     * mutexes unless the list holds a single element
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_adopt_at_back(list_t, void*);
+    /*
+     * Same as dll_adopt_at_back, inserting the element at the start of the list
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_adopt_at_front(list_t, void*);
+    /*
+     * Function responsible for pushing an element at the back of a lock-free
+     * deque (see dll_init_deque) without taking any lock. The deque takes
+     * ownership of the object, as with dll_adopt_at_back, while inline
+     * deques copy it into the node. Other lists are refused
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_push_back(list_t, void*);
+    /*
+     * Same as dll_push_back, pushing the element at the front of the deque
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_push_front(list_t, void*);
+    /*
+     * Same as dll_insert_many_at_back, with the elements inserted at the start
+     * of the list, in the order they are given (items[0] becomes the head)
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned (the list is left untouched)
+     */
+    int dll_insert_many_at_front(list_t, void**, int, void* (*)(void*));
     /*
      * Function responsible for inserting an element into the list keeping the list
      * sorted by a comparison defined by the user with a function called issmaller
@@ -70,6 +276,24 @@ extern "C" {
      */
     int dll_insert_sorted(list_t, void*, int (*)(void*, void*),
             void* (*)(void*));
+    /*
+     * Same as dll_insert_sorted, taking ownership of the given object instead
+     * of duplicating it (see dll_adopt_at_back)
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned
+     */
+    int dll_adopt_sorted(list_t, void*, int (*)(void*, void*));
+    /*
+     * Function responsible for inserting `count` elements into the sorted list
+     * at once: the batch is sorted locally and then merged into the list in a
+     * single pass, in O(n + k log k) instead of O(n * k)
+     * Return values:
+     *      [*] On success,  0 is returned
+     *      [*] On failure,  -1 is returned (the list is left untouched)
+     */
+    int dll_insert_sorted_many(list_t, void**, int, int (*)(void*, void*),
+            void* (*)(void*));
     /*
      * Inserts the element `data` before the `key` element provided. If the key is 
      * not found -1 is returned.
@@ -88,14 +312,45 @@ extern "C" {
      */
     int dll_insert_after(list_t, void*, void* (*)(void*),
             void*, int (*)(void*, void*));
+    /*
+     * Inserts the element `data` at the given position, so that it becomes
+     * the element at that position (0 for the head, the size of the list for
+     * the back). The position is found as in dll_get_at
+     * Not available for concurrent lists
+     * Return values:
+     *      [*]: On success, 0 is returned
+     *      [*]: On error or on position out of range, -1 is returned
+     */
+    int dll_insert_at(list_t, void*, void* (*)(void*), int);
     /*
     * Function that enables accessing data at the list, identified by the 2nd
     * argument, with an is_equal type function as 3rd argument
+    * Not available for mapped lists (see dll_map_open), whose elements are
+    * read-only
     * Return values:
     *      [*] On success, the object is returned
     *      [*] On element not found or on error, NULL is returned
     */
     void* dll_edit_data(list_t, void*, int (*)(void*, void*));
+    /*
+     * Function that finds, in a list sorted with issmaller, the first element
+     * that is equal to `key` (neither of the two is smaller than the other)
+     * With a skip index (see dll_indexEnable) it takes O(log n) comparisons.
+     * Not available for concurrent lists
+     * Return values:
+     *      [*] On success, the object is returned
+     *      [*] On element not found or on error, NULL is returned
+     */
+    void* dll_search_sorted(list_t, void*, int (*)(void*, void*));
+    /*
+     * Function that returns the element at the given position (0 for the
+     * head), walking from the nearer end of the list, or in O(log n) with a
+     * skip index (see dll_indexEnable). Not available for concurrent lists
+     * Return values:
+     *      [*] On success, the object is returned
+     *      [*] On position out of range or on error, NULL is returned
+     */
+    void* dll_get_at(list_t, int);
     /*
      * Function that returns a copy of the data located at the front (Head) of 
      * the list, if getCopy option is true, or the actual data if the option is
@@ -110,7 +365,9 @@ extern "C" {
     const void* dll_get_back(list_t, void* (*)(void*), int);
     /*
      * Function that is responsible for copying src list to dest list
-     * Dest list must be initialized and empty
+     * Dest list must be initialized and empty. The duplicate function must not
+     * be NULL (unless dest is an inline list), while a NULL free_data leaves
+     * the copies alone when the copy fails
      * Return values:
      *      [*] On success, 0 is returned
      *      [*] On failure, -1 is returned
@@ -118,17 +375,229 @@ extern "C" {
      *      [*] On empty source list, 1 is returned
      */
     int dll_copy(list_t, list_t, void* (*)(void*), void (*)(void*));
+    /*
+     * Function responsible for writing a snapshot of the list to the file
+     * descriptor (from its current offset), to be read back by dll_load:
+     * a header followed by the payloads of inline lists as they are, or by
+     * length-prefixed records for other lists, filled in by serialize.
+     * serialize(data, buf, size) writes the element into buf if it fits in
+     * size bytes, and returns the number of bytes it takes (or -1 on error),
+     * so that larger elements are asked for again with enough room (see
+     * serialize_int). It is not used for inline lists and may be NULL.
+     * Snapshots are written in the byte order of the host, with large writes
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_save(list_t, int, int (*)(void*, void*, size_t));
+    /*
+     * Function responsible for reading a snapshot written by dll_save from
+     * the file descriptor, and inserting its elements at the back of the list
+     * (which must store its elements as the saved list did) in batches, as
+     * dll_insert_many_at_back does. deserialize(buf, size) returns a new
+     * element built from the bytes of a record (or NULL on error), which the
+     * list takes over; free_data frees the elements of a batch that could not
+     * be inserted. Both are unused for inline lists, and may be NULL.
+     * The file is read in large blocks, and what was read past the end of the
+     * snapshot is given back (for files that can seek)
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned (the elements read before the error
+     *          are left in the list)
+     */
+    int dll_load(list_t, int, void* (*)(const void*, size_t), void (*)(void*));
+    /*
+     * Function responsible for writing the list to the file at the given
+     * path, to be opened with dll_map_open: a header followed by the nodes,
+     * in list order, linked by their offsets in the file and holding their
+     * element inline. Inline lists keep their element size, while the
+     * elements of other lists are copied byte by byte as objects of
+     * `elem_size` bytes (the 3rd argument, ignored for inline lists), so they
+     * must not point to anything. The file is written aside and renamed over
+     * the old one, which processes that have mapped it keep reading unharmed
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_map_save(list_t, const char*, size_t);
+    /*
+     * Function responsible for opening a file written by dll_map_save as a
+     * read-only list, in O(1): the file is mapped (shared, so that processes
+     * opening the same file read the same pages) and used as it is, without
+     * any loading. Mapped lists support size, isempty, print, get_front,
+     * get_back, get_at (in O(1), their nodes lying in list order),
+     * search_sorted (a binary search), copy (as the source), save, map_save
+     * and the iterators (all but dll_iteratorDeleteCurrentNode), while the
+     * rest of the API, edit_data included, refuses them. The elements handed
+     * out lie in read-only pages, so writing to them crashes the process.
+     * dll_destroy unmaps the file (free_data is not used)
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_map_open(list_t*, const char*);
     /*
      * Function responsible for appending `list b` to `list a`
      * Upon return, the second list pointer (a.k.a. list_t) is going to be freed
      * and nullified, so that it cannot longer be used
+     * Lists that store their elements differently (inline lists of another
+     * element size, see dll_init_inline, or unrolled lists and the others)
+     * cannot be appended, and neither can a list be appended to itself, in
+     * which case both lists are left untouched and the second list pointer is
+     * not nullified
      */
     void dll_append(list_t, list_t*);
+    /*
+     * Function responsible for merging the sorted `list b` into the sorted
+     * `list a` (both sorted with issmaller) in a single O(n+m) pass that
+     * relinks the existing nodes, without allocating or copying anything.
+     * Among equal elements, those of `list a` come first.
+     * As in dll_append, upon return the second list pointer is freed and
+     * nullified, and the same restrictions on the kind of the lists apply
+     * (a list cannot be merged into itself either)
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned (both lists are left untouched)
+     */
+    int dll_merge_sorted(list_t, list_t*, int (*)(void*, void*));
+    /*
+     * Function responsible for moving the elements of `list a`, from the one
+     * of iterator `from` up to the one of iterator `to` (included), in front
+     * of the element of iterator `at` of `list b` (to its back, for an `at` of
+     * -1). The nodes are relinked, without copying or reallocating the
+     * elements, while the iterators of `list a` on them move on as on a
+     * delete (they are all deleted when the whole of `list a` is moved,
+     * `from` and `to` included). The iterators of `list b`, `at` included,
+     * stay valid. Both lists must be of the same kind (see dll_append) and
+     * not concurrent
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned (both lists are left untouched)
+     */
+    int dll_splice(list_t, IteratorID, IteratorID, list_t, IteratorID);
+    /*
+     * Function responsible for cutting the list in two at the element of the
+     * iterator: that element and the ones after it are moved, as in
+     * dll_splice, to a new list of the same kind (without indexes or
+     * finger), which is stored in the 3rd argument. Iterators on the moved
+     * elements, the given one included, migrate to the new list and keep
+     * their IDs, which are no longer valid for the old list. Not available
+     * for concurrent lists
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned (the list is left untouched)
+     */
+    int dll_split_at(list_t, IteratorID, list_t*);
+    /*
+     * Function responsible for sorting the list in ascending order, as
+     * defined by issmaller, with a stable O(n log n) merge sort that relinks
+     * the nodes in place: elements are neither copied nor reallocated, and
+     * iterators keep pointing to the same elements
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_sort(list_t, int (*)(void*, void*));
+    /*
+     * Same as dll_sort, using up to `nthreads` threads: the list is cut into
+     * runs that are sorted concurrently and then merged pairwise
+     * (issmaller is called from several threads at the same time)
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_sort_parallel(list_t, int (*)(void*, void*), int);
+    /*
+     * Function responsible for calling fn(element, ctx) on every element of
+     * the list, using up to `nthreads` threads: the list is cut into as many
+     * runs of consecutive elements in a single pass, and every thread visits
+     * the elements of one run in list order (fn is called from several
+     * threads at the same time). Elements may be changed in place, as long
+     * as their keys are not (see dll_hashEnable), but the list itself must
+     * not be changed by fn. The list is read locked meanwhile (write locked,
+     * for concurrent lists)
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_parallel_for_each(list_t, void (*)(void*, void*), int, void*);
+    /*
+     * Function responsible for folding the elements of the list into the
+     * accumulator pointed to by the 2nd argument (of the size given by the
+     * 3rd one), calling combine(acc, element) for every element, using up to
+     * `nthreads` threads. The list is cut into as many runs as in
+     * dll_parallel_for_each, every run is folded into its own copy of the
+     * initial accumulator, and the partial results are merged into the
+     * accumulator with merge(acc, partial), in list order.
+     * The initial value of the accumulator must therefore be neutral for
+     * merge (0 for a sum, INT_MAX for a minimum) and copyable with memcpy.
+     * With a NULL merge function the fold runs on the calling thread alone
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_reduce(list_t, void*, size_t, void (*)(void*, void*),
+            void (*)(void*, void*), int);
+    /*
+     * Function responsible for building a skip index over the nodes of the
+     * list. The index is kept up to date by all the insert and delete
+     * functions, and lets dll_insert_sorted and dll_search_sorted find their
+     * place in O(log n) comparisons instead of scanning from the head, as
+     * long as the list is kept sorted. The index also counts the nodes its
+     * links skip over, so that the positional functions (dll_get_at,
+     * dll_insert_at, dll_delete_at) take O(log n) as well, sorted list or
+     * not. The order of the nodes and the iterators are not affected
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_indexEnable(list_t);
+    /*
+     * Function responsible for dropping the skip index of the list
+     */
+    void dll_indexDisable(list_t);
+    /*
+     * Function responsible for building a hash index over the elements of the
+     * list, using the given hash function (which must agree with the is_equal
+     * functions used: equal elements must have equal hashes). The index is
+     * kept up to date by all the insert and delete functions, and makes
+     * dll_edit_data, dll_delete, dll_insert_before and dll_insert_after find
+     * their element in O(1) expected time.
+     * Keys are expected to be unique while the index is enabled (with
+     * duplicates any of the matching elements may be picked), and the key of
+     * an element must not be changed through dll_edit_data
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_hashEnable(list_t, unsigned int (*)(void*));
+    /*
+     * Function responsible for dropping the hash index of the list
+     */
+    void dll_hashDisable(list_t);
+    /*
+     * Function responsible for keeping a finger on the node found by the last
+     * keyed search (dll_edit_data, dll_delete, dll_insert_before and
+     * dll_insert_after), where the next one starts, looking on both sides of
+     * it: nearby accesses take O(distance) instead of O(n). With duplicate
+     * keys, the match nearest to the finger is picked. A hash index (see
+     * dll_hashEnable) takes precedence. Not available for concurrent lists
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_fingerEnable(list_t);
+    /*
+     * Function responsible for dropping the finger, searches start at the head
+     */
+    void dll_fingerDisable(list_t);
     /*
      * Function responsible for deleting the element that contains the `key` 
      * given as a 2nd parameter
      * Also, two pointers to functions needed, the 1st for identifying the 
-     * correct element and the second one for freeing it
+     * correct element and the second one for freeing it. A NULL free_data
+     * leaves the element alone (elements owned elsewhere, or living in the
+     * arena of the list), as with all the delete functions of the API
      * Return values:
      *      [*] On success,             0 is returned
      *      [*] On element not found,   1 is returned
@@ -136,23 +605,107 @@ extern "C" {
      */
     int dll_delete(list_t, void*, int (*)(void*, void*), void (*)(void*));
     /*
-     * Deletes the tail element of the list
+     * Deletes the element at the given position (0 for the head), found as
+     * in dll_get_at, freeing it as dll_delete does (free_data may be NULL).
+     * Not available for concurrent lists
+     * Return values:
+     *      [*] On success,                 0 is returned
+     *      [*] On position out of range,   1 is returned
+     *      [*] On error,                   -1 is returned
+     */
+    int dll_delete_at(list_t, int, void (*)(void*));
+    /*
+     * Function responsible for deleting every element for which
+     * pred(element, ctx) returns true, in a single pass over the list, that
+     * also moves the iterators of the deleted elements on to the next element
+     * kept (the last one, if none follows). The skip index, if any, is
+     * rebuilt once at the end.
+     * The deleted elements are freed with free_data, unless it is NULL.
+     * If the last argument is not NULL, the deleted elements are not freed
+     * but handed back in an array (to be freed by the caller) stored there,
+     * or NULL if nothing was deleted. Handing elements back is not available
+     * for inline lists (see dll_init_inline)
+     * Return values:
+     *      [*] On success, the number of deleted elements is returned
+     *      [*] On failure, -1 is returned (the list is left untouched)
+     */
+    int dll_remove_if(list_t, int (*)(void*, void*), void*, void (*)(void*),
+            void***);
+    /*
+     * Deletes the tail element of the list, freeing it as dll_delete does
+     * (free_data may be NULL)
      */
     void dll_delete_back(list_t, void (*)(void*));
     /*
-     * Deletes the head element of the list
+     * Deletes the head element of the list, freeing it as dll_delete does
+     * (free_data may be NULL)
      */
     void dll_delete_front(list_t, void (*)(void*));
+    /*
+     * Unlinks the head element of the list and returns it, so that the caller
+     * takes ownership of the object instead of having it freed
+     * Not available for inline lists (see dll_init_inline), which copy the
+     * element out with dll_pop_front_into instead
+     * Return values:
+     *      [*] On success, the element is returned
+     *      [*] On empty list or on error, NULL is returned
+     */
+    void* dll_pop_front(list_t);
+    /*
+     * Same as dll_pop_front, for the tail element of the list
+     * Return values:
+     *      [*] On success, the element is returned
+     *      [*] On empty list or on error, NULL is returned
+     */
+    void* dll_pop_back(list_t);
+    /*
+     * Unlinks the head element of an inline list (see dll_init_inline),
+     * copying it into `out`, which must hold elem_size bytes. On concurrent
+     * inline lists this is how consumers take elements out of a queue, as
+     * the copy is made before any other thread can reach the node
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On empty list, 1 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_pop_front_into(list_t, void*);
+    /*
+     * Same as dll_pop_front_into, for the tail element of the list
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On empty list, 1 is returned
+     *      [*] On failure, -1 is returned
+     */
+    int dll_pop_back_into(list_t, void*);
+    /*
+     * Function responsible for deleting all the elements of the list, which
+     * stays initialized, with its indexes and finger enabled. Elements are
+     * freed with free_data unless it is NULL (or the list is inline), in
+     * which case pooled and arena lists release their nodes (and arena
+     * storage) block by block, without visiting them
+     * Return values:
+     *      [*] On success, 0 is returned
+     *      [*] On failure, -1 is returned (the list is cleared, but has lost
+     *          its skip index)
+     */
+    int dll_clear(list_t, void (*)(void*));
     /*
      * Function responsible for freeing all the allocated memory
+     * Elements are freed with free_data, unless it is NULL.
+     * Pooled lists whose elements need no free_data (NULL, or inline lists)
+     * are released block by block, without visiting their nodes
      */
     void dll_destroy(list_t*, void (*)(void*));
     /*
      *  Allocates a new Iterator object
-     *  assigning it to the head of the list and then returning its id 
+     *  assigning it to the head of the list and then returning its id
+     *  A list holds at most 65536 iterators at a time, so iterators that are
+     *  no longer needed must be deleted (dll_iteratorDelete). Slots are
+     *  reused, and the ID of a deleted iterator is recognized as stale until
+     *  its slot has been reused 32768 times
      *  Return values:  
      *      [*] On success, the ID of the Iterator is returned 
-     *      [*] On failure, -1 is returned
+     *      [*] On failure or on empty list, -1 is returned
      */
     IteratorID dll_iteratorRequest(list_t);
     /*
@@ -222,7 +775,8 @@ extern "C" {
      * After the deletion the iterator points to the next element of the list
      * (towards the end). If the element to be destroyed is the last element of the
      * list, which means that the list will be empty, all the iterators are 
-     * invalidated
+     * invalidated. The element is freed as in dll_delete (free_data may be
+     * NULL)
      * Return values:
      *         [*] On success, 0 is returned
      *         [*] On failure, -1 is returned